@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+"""Converts a memory dump of OS_Trace (Src/OS/OsTrace.h) into a Chrome
+trace JSON file, viewable in chrome://tracing or https://ui.perfetto.dev.
+
+Example (J-Link Commander, then decode):
+  J-Link> savebin trace.bin <address of OS_Trace> <sizeof(OS_Trace)>
+  python3 OsTraceDecode.py trace.bin -o trace.json --hz 180000000 --name 1=Blinky --name 2=TogglePC3
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+OS_TRACE_MAGIC       = 0x5254534F
+OS_TRACE_STAMP_BITS  = 21
+OS_TRACE_ID_SHIFT    = 21
+OS_TRACE_EVENT_SHIFT = 29
+
+EVENTS = ("switch", "ready", "delay", "tick", "isr_enter", "isr_exit", "sched", "pend")
+
+EXCEPTIONS = { 0xF2: "NMI", 0xF4: "MemManage", 0xF5: "BusFault", 0xF6: "UsageFault",
+               0xFB: "SVCall", 0xFC: "DebugMon", 0xFE: "PendSV", 0xFF: "SysTick" }
+
+PID_THREADS    = 1
+PID_INTERRUPTS = 2
+TID_TICK       = 0x100
+
+
+def find_trace(data, offset):
+  """Returns (index, words) of the OSTrace structure in the dump."""
+  if offset is None:
+    offset = data.find(struct.pack("<I", OS_TRACE_MAGIC))
+    if offset < 0:
+      sys.exit("OsTraceDecode: no OS_Trace (magic 0x%08X) in the dump" % OS_TRACE_MAGIC)
+
+  magic, size, index = struct.unpack_from("<III", data, offset)
+
+  if magic != OS_TRACE_MAGIC or size == 0 or (size & (size - 1)) != 0:
+    sys.exit("OsTraceDecode: invalid OS_Trace header at offset %d" % offset)
+
+  words = struct.unpack_from("<%dI" % size, data, offset + 12)
+
+  # Oldest event first
+  if index <= size:
+    return index, list(words[:index])
+
+  start = index % size
+  return index, list(words[start:] + words[:start])
+
+
+def decode(words):
+  """Yields (cycles, event, id) with the timestamps unwrapped.
+
+  A tick with a non-zero id ends a tickless idle sleep: the id is 1 + the
+  whole 2^21-cycle periods since the previous word (the start of the sleep),
+  which the masked difference of the timestamps cannot show.
+  """
+  mask  = (1 << OS_TRACE_STAMP_BITS) - 1
+  time  = 0
+  stamp = None
+
+  for word in words:
+    event = EVENTS[word >> OS_TRACE_EVENT_SHIFT]
+    ident = (word >> OS_TRACE_ID_SHIFT) & 0xFF
+    now   = word & mask
+
+    if stamp is not None:
+      time += (now - stamp) & mask
+
+      if event == "tick" and ident != 0:
+        time += (ident - 1) << OS_TRACE_STAMP_BITS
+
+    stamp = now
+
+    if event == "tick" and ident != 0:
+      yield time, "wake", 0
+    else:
+      yield time, event, ident
+
+
+def irq_name(ident):
+  return EXCEPTIONS.get(ident, "IRQ%d" % ident)
+
+
+def to_chrome(events, hz, names):
+  """Builds the Chrome trace event list."""
+  usec    = 1.0e6 / hz
+  trace   = []
+  seen    = set()
+  running = None
+  isrs    = set()
+  load    = {}
+
+  def thread_name(ident):
+    return names.get(ident, "Idle" if ident == 0 else "Thread %d" % ident)
+
+  def meta(pid, tid, name):
+    trace.append({ "name": "thread_name", "ph": "M", "pid": pid, "tid": tid, "args": { "name": name } })
+
+  last = 0
+
+  for cycles, event, ident in events:
+    ts   = cycles * usec
+    last = cycles
+
+    if event in ("isr_enter", "isr_exit"):
+      if ident not in isrs:
+        isrs.add(ident)
+        meta(PID_INTERRUPTS, ident, irq_name(ident))
+
+      trace.append({ "name": irq_name(ident), "ph": "B" if event == "isr_enter" else "E",
+                     "pid": PID_INTERRUPTS, "tid": ident, "ts": ts })
+      continue
+
+    if event == "wake":
+      trace.append({ "name": "wake", "ph": "i", "s": "t", "pid": PID_INTERRUPTS, "tid": TID_TICK, "ts": ts })
+      continue
+
+    if event == "tick":
+      trace.append({ "name": "tick", "ph": "i", "s": "t", "pid": PID_INTERRUPTS, "tid": TID_TICK, "ts": ts })
+      continue
+
+    if ident not in seen:
+      seen.add(ident)
+      meta(PID_THREADS, ident, thread_name(ident))
+
+    if event == "switch":
+      if running is not None:
+        prev, start = running
+        trace.append({ "name": "run", "ph": "X", "pid": PID_THREADS, "tid": prev,
+                       "ts": start * usec, "dur": (cycles - start) * usec })
+        load[prev] = load.get(prev, 0) + (cycles - start)
+
+      running = (ident, cycles)
+    else:
+      trace.append({ "name": event, "ph": "i", "s": "t", "pid": PID_THREADS, "tid": ident, "ts": ts })
+
+  if running is not None:
+    prev, start = running
+    trace.append({ "name": "run", "ph": "X", "pid": PID_THREADS, "tid": prev,
+                   "ts": start * usec, "dur": (last - start) * usec })
+    load[prev] = load.get(prev, 0) + (last - start)
+
+  meta(PID_INTERRUPTS, TID_TICK, "Tick")
+
+  return trace, { thread_name(ident): cycles for ident, cycles in load.items() }
+
+
+def main():
+  parser = argparse.ArgumentParser(description="Converts an OS_Trace memory dump into Chrome trace JSON.")
+  parser.add_argument("dump", help="binary dump containing OS_Trace")
+  parser.add_argument("-o", "--output", help="JSON output file (default: stdout)")
+  parser.add_argument("--hz", type=float, default=180.0e6, help="DWT_CYCCNT frequency (default: 180 MHz)")
+  parser.add_argument("--offset", type=int, help="offset of OS_Trace in the dump (default: search the magic)")
+  parser.add_argument("--name", action="append", default=[], metavar="ID=NAME", help="name of a thread trace id")
+  args = parser.parse_args()
+
+  names = {}
+
+  for item in args.name:
+    ident, _, name = item.partition("=")
+    names[int(ident, 0)] = name
+
+  with open(args.dump, "rb") as dump:
+    data = dump.read()
+
+  index, words = find_trace(data, args.offset)
+  trace, load  = to_chrome(decode(words), args.hz, names)
+
+  text = json.dumps({ "traceEvents": trace, "displayTimeUnit": "ns" })
+
+  if args.output:
+    with open(args.output, "w") as out:
+      out.write(text)
+  else:
+    sys.stdout.write(text)
+
+  total = sum(load.values())
+
+  sys.stderr.write("OsTraceDecode: %d events decoded (%d recorded)\n" % (len(words), index))
+
+  for name, cycles in sorted(load.items(), key=lambda item: -item[1]):
+    sys.stderr.write("  %-20s %6.2f %%\n" % (name, (100.0 * cycles / total) if total else 0.0))
+
+
+if __name__ == "__main__":
+  main()
@@ -8,12 +8,14 @@
 /*--------------------------------------------------------------
 - Global Variables
 ---------------------------------------------------------------*/
-uint32_t Blinky_Stack   [40U];
-uint32_t TogglePC3_Stack[40U];
-uint32_t IdleThread_Stack[40U];
+MCU_THREAD_STACK uint32_t IdleThread_Stack[40U];
 
-OSThread Blinky_Thread;
-OSThread TogglePC3_Thread;
+/* Reset to first thread dispatch in DWT cycles, also read with the debugger */
+volatile uint32_t App_BootCycles;
+
+/* Started by OS_Init: TCB, stack (bytes) and priority fixed at build time */
+OS_THREAD_DEFINE(Blinky,    3U, Blinky_Main,    160U);
+OS_THREAD_DEFINE(TogglePC3, 2U, TogglePC3_Main, 160U);
 
 
 /*--------------------------------------------------------------
@@ -21,6 +23,7 @@ OSThread TogglePC3_Thread;
 ---------------------------------------------------------------*/
 void Blinky_Main    (void);
 void TogglePC3_Main (void);
+static void App_ReportBoot(void);
 
 
 /*--------------------------------------------------------------
@@ -28,28 +31,67 @@ void TogglePC3_Main (void);
 ---------------------------------------------------------------*/
 void Blinky_Main(void)
 {
+  /* Absolute wakeups: the loop body does not stretch the period */
+  uint32_t Wake;
+
+  App_ReportBoot();
+
+  Wake = OS_GetTickCount();
+
   while(1U)
   {
     Led_On();
-    OS_msDelay(10);
+    Wake += 10U;
+    (void) OS_DelayUntil(Wake);
     Led_Off();
-    OS_msDelay(20);
+    Wake += 20U;
+    (void) OS_DelayUntil(Wake);
   }
 }
 
 
 void TogglePC3_Main(void)
 {
+  uint32_t Wake = OS_GetTickCount();
+
   while(1U)
   {
     PC3_On();
-    OS_msDelay(20);
+    Wake += 20U;
+    (void) OS_DelayUntil(Wake);
     PC3_Off();
-    OS_msDelay(40);
+    Wake += 40U;
+    (void) OS_DelayUntil(Wake);
   }
 }
 
 
+/*--------------------------------------------------------------
+- @brief App_ReportBoot
+
+- @desc Reports the boot time (reset to first thread dispatch) on PC10:
+        one pulse as long as the boot itself, busy-waited on the cycle
+        counter. Blinky runs first, so the pulse precedes the short
+        idle pulses of OS_OnIdle on the same pin.
+
+- @param void
+- @return void
+---------------------------------------------------------------*/
+static void App_ReportBoot(void)
+{
+  const uint32_t Start = DWT_CYCCNT;
+
+  App_BootCycles = OS_GetBootCycles();
+
+  PC10_On();
+
+  while((DWT_CYCCNT - Start) < App_BootCycles)
+  {
+  }
+
+  PC10_Off();
+}
+
 
 /*--------------------------------------------------------------
 - Main
@@ -66,23 +108,9 @@ int main(void)
   /*Initialize Gpio pins and EXTI */
   GPIO_Init();
 
-  /* Os Initialization */
+  /* Os Initialization, starts the Blinky and PC3 Toggle threads */
   OS_Init(IdleThread_Stack, sizeof(IdleThread_Stack));
 
-  /* Initialize Cortex-M ISR stack frame for the Blinky1 thread */
-  OSThread_Start(&Blinky_Thread,
-                 3U,
-                 &Blinky_Main,
-                 Blinky_Stack,
-                 sizeof(Blinky_Stack));
-
-  /* Initialize Cortex-M ISR stack frame for the PC3 Toggle thread */
-  OSThread_Start(&TogglePC3_Thread,
-                 2U,
-                 &TogglePC3_Main,
-                 TogglePC3_Stack,
-                 sizeof(TogglePC3_Stack));
-
   /* Run Os */
   OS_Run();
 }
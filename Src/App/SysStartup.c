@@ -1,5 +1,7 @@
 #include <stdint.h>
 
+#include <Mcal/Mcu.h>
+
 /*----------------------------------------------------------------------------
 - Initialization Functions
 -----------------------------------------------------------------------------*/
@@ -7,6 +9,9 @@ void crt_init_ram(void);
 void crt_init_ctors(void);
 void __my_startup() __attribute__((used, noinline));
 
+static void crt_copy_words(uint32_t *dst, const uint32_t *dst_end, const uint32_t *src);
+static void crt_zero_words(uint32_t *dst, const uint32_t *dst_end);
+
 
 /*----------------------------------------------------------------------------
 - External Symbols
@@ -17,6 +22,9 @@ extern uintptr_t _data_begin;     /* Start address for the .data section.
 extern uintptr_t _data_end;       /* End address for the .data section.                                    */
 extern uintptr_t _bss_begin;      /* Start address for the .bss section.                                   */
 extern uintptr_t _bss_end;        /* End address for the .bss section.                                     */
+extern uintptr_t _rom_ramfunc_begin; /* Start address for the ROM image of the .ramfunc section.            */
+extern uintptr_t _ramfunc_begin;  /* Start address for the .ramfunc section (code run from RAM).           */
+extern uintptr_t _ramfunc_end;    /* End address for the .ramfunc section.                                 */
 
 typedef void(*function_type)(void);
 extern function_type _ctors_end;
@@ -39,6 +47,10 @@ void __my_startup(void)
   /* the base position of the interrupt vector table. */
   /* So we do nothing here.                           */
 
+  /* Start the cycle counter first, so that the boot  */
+  /* time (OS_GetBootCycles) counts from the reset.   */
+  Dwt_Init();
+
   /* Initialize statics from ROM to RAM.        */
   /* Zero-clear default-initialized static RAM. */
   crt_init_ram();
@@ -60,35 +72,89 @@ void __my_startup(void)
 
 
 /*----------------------------------------------------------------------------
-- @brief crt_init_ram
+- @brief crt_copy_words
 -
-- @desc Initializes RAM by copying the .data segment from ROM and
-        zero-clearing the .bss segment.
+- @desc Copies words from ROM to RAM, four per pass (paired into LDM/STM
+        or LDRD/STRD by the compiler; this file is built with -O2, see
+        make_stm32f446re.gmk), then the rest.
 -
-- @param void
+- @param dst       First word to write
+- @param dst_end   End of the destination (word aligned)
+- @param src       First word to read
 - @return void
 -----------------------------------------------------------------------------*/
-void crt_init_ram(void)
+static void crt_copy_words(uint32_t *dst, const uint32_t *dst_end, const uint32_t *src)
 {
-  /* Copy the data segment initializers from ROM to RAM.*/
-  /* Note that all data segments are aligned by 4.      */
-  const unsigned size_data = (unsigned) ((uint8_t*) (&_data_end) - (uint8_t*) &_data_begin);
+  while((dst_end - dst) >= 4)
+  {
+    dst[0U] = src[0U];
+    dst[1U] = src[1U];
+    dst[2U] = src[2U];
+    dst[3U] = src[3U];
+
+    dst += 4U;
+    src += 4U;
+  }
 
-  for(unsigned i = 0U; i < size_data; ++i)
+  while(dst < dst_end)
   {
-    ((uint8_t*) &_data_begin)[i] = ((const uint8_t*) &_rom_data_begin)[i];
+    *dst++ = *src++;
   }
+}
 
-  const unsigned size_bss = (unsigned) ((uint8_t*) (&_bss_end) - (uint8_t*) &_bss_begin);
 
-  /* Clear the bss segment. */
-  for(unsigned i = 0U; i < size_bss; ++i)
+/*----------------------------------------------------------------------------
+- @brief crt_zero_words
+-
+- @desc Clears words, four per pass, then the rest.
+-
+- @param dst       First word to clear
+- @param dst_end   End of the area (word aligned)
+- @return void
+-----------------------------------------------------------------------------*/
+static void crt_zero_words(uint32_t *dst, const uint32_t *dst_end)
+{
+  while((dst_end - dst) >= 4)
+  {
+    dst[0U] = 0U;
+    dst[1U] = 0U;
+    dst[2U] = 0U;
+    dst[3U] = 0U;
+
+    dst += 4U;
+  }
+
+  while(dst < dst_end)
   {
-    ((uint8_t*) &_bss_begin)[i] = (uint8_t) 0U;
+    *dst++ = 0U;
   }
 }
 
 
+/*----------------------------------------------------------------------------
+- @brief crt_init_ram
+-
+- @desc Initializes RAM by copying the .data segment and the code run
+        from RAM (.ramfunc) from ROM and zero-clearing the .bss segment.
+        All segments are aligned by 4 (see the linker script), so they
+        are handled by words.
+-
+- @param void
+- @return void
+-----------------------------------------------------------------------------*/
+void crt_init_ram(void)
+{
+  /* Copy the data segment initializers from ROM to RAM. */
+  crt_copy_words((uint32_t*) &_data_begin, (const uint32_t*) &_data_end, (const uint32_t*) &_rom_data_begin);
+
+  /* Copy the code run from RAM (MCU_RAMFUNC) from ROM to RAM. */
+  crt_copy_words((uint32_t*) &_ramfunc_begin, (const uint32_t*) &_ramfunc_end, (const uint32_t*) &_rom_ramfunc_begin);
+
+  /* Clear the bss segment. */
+  crt_zero_words((uint32_t*) &_bss_begin, (const uint32_t*) &_bss_end);
+}
+
+
 
 /*----------------------------------------------------------------------------
 - @brief crt_init_ctors
@@ -1,7 +1,13 @@
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include "Mcal/Gpio.h"
+#include "Mcal/Gpt.h"
 #include "Mcal/Mcu.h"
+#include "Port/OsPort.h"
 #include "Os.h"
+#include "OsTimer.h"
+#include "OsTrace.h"
 
 
 /*----------------------------------------------------------------------------
@@ -11,29 +17,68 @@ OSThread * volatile OS_Curr;    /* pointer to the current thread */
 OSThread * volatile OS_Next;    /* pointer to the next thread to run */
 
 OSThread  IdleThread;
-OSThread *OS_Thread[32U + 1U];  /* array of threads started so far */
+OSThread *OS_Thread[OS_CFG_MAX_PRIO + 1U];     /* threads started per priority level (linked via PrioNext) */
+OSThread *OS_ReadyList[OS_CFG_MAX_PRIO + 1U];  /* circular ready list per priority level, the head runs */
 
-uint8_t   OS_CurrIdx;           /* current thread index for round robin scheduling */
-uint32_t  OS_ReadySet;          /* bitmask of threads that are ready to run */
-uint32_t  OS_DelayedSet;        /* bitmask of threads that are delayed */
+OSPrioSet OS_ReadySet;          /* priority levels with ready threads */
+OSThread *OS_DelayedList;       /* delta list of delayed threads, nearest expiry first */
+volatile uint32_t OS_TickCount; /* ticks since OS_Run (wraps around) */
 
-/*----------------------------------------------------------------------------
-- OS Function Declarations
------------------------------------------------------------------------------*/
-__attribute__ ((naked)) void PendSV_Handler(void);
-static void IdleThread_Main(void);
+static uint32_t OS_BootCycles;  /* DWT_CYCCNT at the first thread dispatch */
+static bool     OS_Running;     /* set by OS_Run: no switch is requested before */
+
+/* Thread table of OS_THREAD_DEFINE, bounds set by the linker (weak: the
+   section does not exist in a program without static threads) */
+extern const OSThreadDef __start_os_thread_def[] __attribute__((weak));
+extern const OSThreadDef __stop_os_thread_def[]  __attribute__((weak));
+
+/* Priorities are kept in a uint8_t, 0 is the idle thread */
+_Static_assert((OS_CFG_MAX_PRIO >= 1U) && (OS_CFG_MAX_PRIO <= 255U), "OS_CFG_MAX_PRIO must be 1 .. 255");
+
+/* Pattern of unused stack words (also checked literally in PendSV_Handler) */
+#define OS_STACK_FILL         0xFACEB00CUL
+
+#if (OS_CFG_THREAD_STATS == 1)
+static uint32_t OS_StatsStamp;  /* DWT_CYCCNT when cycles were last accounted */
+static uint64_t OS_StatsTotal;  /* cycles accounted to all threads */
+#endif
 
+#if (OS_CFG_TRACE == 1)
+static uint8_t  OS_TraceNextId; /* trace id of the next thread started */
+#endif
+
+#if (OS_CFG_HR_TIME == 1)
+static OSThread *OS_HrList;     /* threads delayed in microseconds, nearest wakeup first */
+#endif
 
 /*----------------------------------------------------------------------------
-- @brief LOG2
--
-- @desc Returns the position of the highest set bit (1-based) in a 32-bit
-  integer, used for priority selection in the OS.
--
-- @param x   32-bit input value
-- @return uint32_t  Highest set bit position
+- OS Function Declarations
 -----------------------------------------------------------------------------*/
-#define LOG2(x) (32U - (uint32_t)__builtin_clz(x))
+static void IdleThread_Main(void);
+static void OSThread_Exit  (void);
+static void OS_DelayInsert (OSThread *Thread, uint32_t Ticks);
+MCU_RAMFUNC static void OS_DelayRemove (OSThread *Thread);
+static bool OS_IsReady     (const OSThread *Thread);
+MCU_RAMFUNC static void OS_ReadyInsert (OSThread *Thread);
+static void OS_ReadyRemove (OSThread *Thread);
+static void OS_PrioLink    (OSThread *Thread);
+static void OS_PrioUnlink  (OSThread *Thread);
+MCU_RAMFUNC static void OS_WaitRemove  (OSThread *Thread);
+MCU_RAMFUNC static uint32_t OS_PrioSetHighestBelow(const OSPrioSet *Set, uint32_t Prio);
+
+#if (OS_CFG_TICKLESS_IDLE == 1)
+static uint32_t OS_NextTimeout   (void);
+static void     OS_TickSuppressed(uint32_t Ticks);
+#endif
+
+#if (OS_CFG_HR_TIME == 1)
+static void OS_HrInsert(OSThread *Thread);
+static void OS_HrRemove(OSThread *Thread);
+#endif
+
+#if (OS_CFG_THREAD_STATS == 1)
+MCU_RAMFUNC static void OS_StatsAccount(void);
+#endif
 
 
 /*----------------------------------------------------------------------------
@@ -57,8 +102,10 @@ static void IdleThread_Main(void)
 /*----------------------------------------------------------------------------
 - @brief OS_Init
 
-- @desc Initializes the OS by setting PendSV to lowest priority and
-        starting the idle thread.
+- @desc Initializes the OS: sets up the context switch of the port
+        (PendSV priority, lazy FPU stacking) and starts the idle thread,
+        with OS_CFG_TIMERS the timer thread, and the threads of the
+        flash table built by OS_THREAD_DEFINE (in link order).
 
 - @param StackStorage   Idle thread stack base address
          SatckSize      Idle thread stack size
@@ -67,42 +114,63 @@ static void IdleThread_Main(void)
 -----------------------------------------------------------------------------*/
 void OS_Init(void *StackStorage, uint32_t SatckSize)
 {
-  /* set the PendSV interrupt priority to the lowest level 0xFF */
-  NVIC_SYS_PRI3_R |= (0xFFUL << 16U);
+  const OSThreadDef *Def;
+
+  OSPort_Init();
 
   /* Start IdleThread thread */
   OSThread_Start(&IdleThread, 0U, &IdleThread_Main, StackStorage, SatckSize);
+
+#if (OS_CFG_TIMERS == 1)
+  /* Start the timer thread */
+  OS_TimerInit();
+#endif
+
+  /* Start the threads of OS_THREAD_DEFINE in one pass over the table */
+  for (Def = __start_os_thread_def; Def < __stop_os_thread_def; ++Def)
+  {
+    OSThread_Start(Def->TCB, Def->Prio, Def->Handler, Def->StkStorage, Def->StkSize);
+  }
 }
 
 /*----------------------------------------------------------------------------
 - @brief OS_Sched
 
-- @desc Selects the highest-priority ready thread and triggers PendSV
-        if a context switch is required.
+- @desc Selects the head of the highest-priority ready list and triggers
+        PendSV if a context switch is required. Does nothing before
+        OS_Run: a tick or an interrupt that arrives while main() is still
+        setting up must not switch away from the startup stack.
 
 - @param void
 
 - @return void
 -----------------------------------------------------------------------------*/
-void OS_Sched(void)
+MCU_RAMFUNC void OS_Sched(void)
 {
   /* Select the next thread to execute */
   OSThread* NextThread;
 
+  if (!OS_Running)
+  {
+    return;
+  }
+
   /* Check for idle condition */
-  if (OS_ReadySet == 0U)
+  if (OS_PrioSetIsEmpty(&OS_ReadySet))
   {
-    NextThread = OS_Thread[0U]; /* the idle thread */
+    NextThread = &IdleThread;
   }
   else
   {
-    /* Pick the highest-priority ready thread */
-    NextThread = OS_Thread[LOG2(OS_ReadySet)];
+    /* Pick the highest-priority level, its threads take turns at the head */
+    NextThread = OS_ReadyList[OS_PrioSetHighest(&OS_ReadySet)];
   }
 
   /* trigger PendSV, if needed */
   if(NextThread != OS_Curr)
   {
+    OS_TRACE(OS_TRACE_SCHED, NextThread->TraceId);
+
     OS_Next  = NextThread;
     ICSR    |= (1UL << 28U); /* set PendSV pending bit */
   }
@@ -113,7 +181,8 @@ void OS_Sched(void)
 - @brief OS_OnIdle
 
 - @desc  Executes idle-time actions and places CPU in low-power
-         wait-for-interrupt state.
+         wait-for-interrupt state. With OS_CFG_TICKLESS_IDLE the SysTick
+         is reprogrammed to wake up at the nearest thread timeout.
 
 - @param void
 
@@ -124,226 +193,1418 @@ void OS_OnIdle(void)
   PC10_On();
   PC10_Off();
 
+#if (OS_CFG_TICKLESS_IDLE == 1)
+  /* PRIMASK instead of the kernel ceiling: WFI does not wake up for an
+     interrupt masked by BASEPRI, but does for one masked by PRIMASK */
+  Disable_Irq();
+
+  if(OS_PrioSetIsEmpty(&OS_ReadySet))
+  {
+    /* Sleep until the nearest timeout instead of waking every tick */
+    const uint32_t IdleTicks = OS_NextTimeout();
+
+    if((IdleTicks > 1U) && SysTick_StartOneShot(IdleTicks))
+    {
+      /* A pending interrupt wakes the CPU even with interrupts disabled */
+      OS_TRACE_SLEEP();
+      Wait_For_Interrupt();
+      OS_TRACE_WAKE();
+
+      OS_TickSuppressed(SysTick_StopOneShot());
+    }
+    else
+    {
+      Wait_For_Interrupt();
+    }
+  }
+
+  Enable_Irq();
+#else
   /* Stop the CPU and Wait for Interrupt */
   Wait_For_Interrupt();
+#endif
+}
+
+
+#if (OS_CFG_TICKLESS_IDLE == 1)
+/*----------------------------------------------------------------------------
+- @brief OS_NextTimeout
+
+- @desc Returns the number of ticks until the nearest delayed thread
+        expires, i.e. the delta of the head of the delayed list, or the
+        nearest software timer if it expires earlier.
+        Must be called in a critical section.
+
+- @param void
+
+- @return uint32_t  Ticks to the nearest timeout (STK_MAX_IDLE_TICKS if no
+                    thread is delayed)
+-----------------------------------------------------------------------------*/
+static uint32_t OS_NextTimeout(void)
+{
+  uint32_t Ticks = (OS_DelayedList != (OSThread *)0) ? OS_DelayedList->TimeOut : STK_MAX_IDLE_TICKS;
+
+#if (OS_CFG_TIMERS == 1)
+  const uint32_t TimerTicks = OS_TimerNextTimeout();
+
+  Ticks = (TimerTicks < Ticks) ? TimerTicks : Ticks;
+#endif
+
+  return Ticks;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_TickSuppressed
+
+- @desc Accounts for ticks that elapsed while the SysTick was suppressed:
+        corrects the system time and all timeouts. Since the timeouts are
+        kept as deltas, only the head of the delayed list is adjusted.
+        No timeout can expire here since the sleep never exceeds the
+        nearest one.
+        Must be called in a critical section.
+
+- @param Ticks   Number of suppressed ticks
+
+- @return void
+-----------------------------------------------------------------------------*/
+static void OS_TickSuppressed(uint32_t Ticks)
+{
+  Gpt_AddElapsedTicks(Ticks);
+
+  OS_TickCount += Ticks;
+
+  if (OS_DelayedList != (OSThread *)0)
+  {
+    OS_DelayedList->TimeOut -= Ticks;
+  }
+
+#if (OS_CFG_TIMERS == 1)
+  OS_TimerTickSuppressed(Ticks);
+#endif
 }
+#endif
 
 
 /*----------------------------------------------------------------------------
 - @brief OS_msDelay
 
-- @desc Puts the current thread into the delayed set for a given number
+- @desc Puts the current thread into the delayed list for a given number
         of ticks and triggers rescheduling
 
-- @param Ticks   Delay duration in system ticks
+- @param Ticks   Delay duration in system ticks (0: until the next tick)
 
 - @return void
 -----------------------------------------------------------------------------*/
 void OS_msDelay(uint32_t Ticks)
 {
-  Disable_Irq();
+  OSCritical Crit;
+
+  OS_CRITICAL_ENTER(Crit);
 
-  OS_Curr->TimeOut = Ticks;
+  OS_TRACE(OS_TRACE_DELAY, OS_Curr->TraceId);
 
-  OS_ReadySet   &= ~(1U << (OS_Curr->Prio - 1U));
-  OS_DelayedSet |=  (1U << (OS_Curr->Prio - 1U));
+  OS_DelayInsert(OS_Curr, Ticks);
+  OS_ReadyRemove(OS_Curr);
 
   OS_Sched();
 
-  Enable_Irq();
+  OS_CRITICAL_EXIT(Crit);
 }
 
+
 /*----------------------------------------------------------------------------
-- @brief OS_Tick
+- @brief OS_DelayUntil
 
-- @desc Updates delayed threads each system tick, moves threads whose
-        timeouts expire into the ready set.
+- @desc Puts the current thread into the delayed list until the tick count
+        reaches an absolute value. Unlike a relative delay, the time the
+        thread ran before the call does not shift the wakeup.
+
+- @param Tick    Tick count to wake up at (compared modulo 2^32, at most
+                 2^31 - 1 ticks ahead)
+
+- @return OSStatus  OS_OK after the delay (or if Tick is the current tick),
+                    OS_TIMEOUT without delay if Tick has already passed
+-----------------------------------------------------------------------------*/
+OSStatus OS_DelayUntil(uint32_t Tick)
+{
+  OSStatus   Status = OS_OK;
+  OSCritical Crit;
+  int32_t    Left;
+
+  OS_CRITICAL_ENTER(Crit);
+
+  Left = (int32_t)(Tick - OS_TickCount);
+
+  if (Left > 0)
+  {
+    OS_TRACE(OS_TRACE_DELAY, OS_Curr->TraceId);
+
+    OS_DelayInsert(OS_Curr, (uint32_t)Left);
+    OS_ReadyRemove(OS_Curr);
+
+    OS_Sched();
+  }
+  else if (Left < 0)
+  {
+    Status = OS_TIMEOUT;
+  }
+
+  OS_CRITICAL_EXIT(Crit);
+
+  return Status;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_GetTickCount
+
+- @desc Returns the number of ticks since OS_Run, including the ticks
+        suppressed by tickless idle. Wraps around after 2^32 ticks.
+
+- @param void
+
+- @return uint32_t  Tick count
+-----------------------------------------------------------------------------*/
+uint32_t OS_GetTickCount(void)
+{
+  return OS_TickCount;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_GetBootCycles
+
+- @desc Returns the boot time: the cycle counter read by OS_Run right
+        before the first thread is dispatched. The startup code starts
+        the counter at reset, so this covers the RAM initialization, the
+        clock setup and the application init up to OS_Run (cycles at the
+        clock of each phase).
+
+- @param void
+
+- @return uint32_t  DWT cycles from reset to the first dispatch
+-----------------------------------------------------------------------------*/
+uint32_t OS_GetBootCycles(void)
+{
+  return OS_BootCycles;
+}
+
+
+#if (OS_CFG_HR_TIME == 1)
+/*----------------------------------------------------------------------------
+- @brief OS_GetMicroseconds
+
+- @desc Returns the free-running microsecond counter of the target, started
+        by OS_Run. Wraps around after 2^32 us (about 71 minutes).
 
 - @param void
 
+- @return uint32_t  Time in microseconds
+-----------------------------------------------------------------------------*/
+uint32_t OS_GetMicroseconds(void)
+{
+  return Gpt_HrGetTime();
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_usDelay
+
+- @desc Blocks the current thread for a number of microseconds. The wakeup
+        comes from the compare interrupt of the microsecond counter, not
+        from the tick.
+
+- @param Us   Delay in microseconds (at most 2^31 - 1)
+
+- @return void
+-----------------------------------------------------------------------------*/
+void OS_usDelay(uint32_t Us)
+{
+  (void) OS_usDelayUntil(Gpt_HrGetTime() + Us);
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_usDelayUntil
+
+- @desc Puts the current thread into the microsecond delay list until the
+        microsecond counter reaches an absolute value, the counterpart of
+        OS_DelayUntil for loops faster than the tick.
+
+- @param Us    Microsecond time to wake up at (compared modulo 2^32, at
+               most 2^31 - 1 us ahead)
+
+- @return OSStatus  OS_OK after the delay (or if Us is the current time),
+                    OS_TIMEOUT without delay if Us has already passed
+-----------------------------------------------------------------------------*/
+OSStatus OS_usDelayUntil(uint32_t Us)
+{
+  OSStatus   Status = OS_OK;
+  OSCritical Crit;
+  int32_t    Left;
+
+  OS_CRITICAL_ENTER(Crit);
+
+  Left = (int32_t)(Us - Gpt_HrGetTime());
+
+  if (Left > 0)
+  {
+    OS_TRACE(OS_TRACE_DELAY, OS_Curr->TraceId);
+
+    OS_Curr->HrWake = Us;
+
+    OS_HrInsert(OS_Curr);
+    OS_ReadyRemove(OS_Curr);
+
+    OS_Sched();
+  }
+  else if (Left < 0)
+  {
+    Status = OS_TIMEOUT;
+  }
+
+  OS_CRITICAL_EXIT(Crit);
+
+  return Status;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_HrInsert
+
+- @desc Inserts a thread into the microsecond delay list, ordered by
+        wakeup time (modulo 2^32), after the threads waking up at the
+        same time. A new head re-arms the alarm of the counter.
+        Must be called in a critical section.
+
+- @param Thread  Thread to delay (HrWake set)
+
 - @return void
 -----------------------------------------------------------------------------*/
-void OS_Tick(void)
+static void OS_HrInsert(OSThread *Thread)
 {
-  uint32_t pendingDelayedThreads = OS_DelayedSet;
+  OSThread **Link = &OS_HrList;
 
-  while (pendingDelayedThreads != 0U)
+  while ((*Link != (OSThread *)0) && ((int32_t)((*Link)->HrWake - Thread->HrWake) <= 0))
   {
-    /* Find the highest-priority delayed thread */
-    uint32_t Index      = LOG2(pendingDelayedThreads);
-    OSThread *Thread    = OS_Thread[Index];
-    uint32_t ThreadBit  = (1U << (Thread->Prio - 1U));
+    Link = &(*Link)->HrNext;
+  }
 
-    /* Decrement timeout counter */
-    if (--Thread->TimeOut == 0U)
-    {
-      /* Timeout expired: move thread to ready set */
-      OS_ReadySet   |= ThreadBit;
-      OS_DelayedSet &= ~ThreadBit;
-    }
+  Thread->HrNext = *Link;
+  *Link          = Thread;
 
-    /* Remove this thread from local working set */
-    pendingDelayedThreads &= ~ThreadBit;
+  if (OS_HrList == Thread)
+  {
+    Gpt_HrStartAlarm(Thread->HrWake);
   }
 }
 
 
 /*----------------------------------------------------------------------------
-- @brief OS_Run
+- @brief OS_HrRemove
 
-- @desc
+- @desc Removes a thread from the microsecond delay list before its wakeup
+        (e.g. stopped). Does nothing if the thread is not in the list.
+        Must be called in a critical section.
 
-- @param void
+- @param Thread  Thread to remove
 
 - @return void
 -----------------------------------------------------------------------------*/
-void OS_Run(void)
+static void OS_HrRemove(OSThread *Thread)
 {
-  /* callback to configure and start interrupts */
-  OS_OnStartup();
+  OSThread **Link = &OS_HrList;
 
-  Disable_Irq();
-  OS_Sched();
-  Enable_Irq();
+  while ((*Link != (OSThread *)0) && (*Link != Thread))
+  {
+    Link = &(*Link)->HrNext;
+  }
+
+  if (*Link == (OSThread *)0)
+  {
+    return;
+  }
+
+  *Link          = Thread->HrNext;
+  Thread->HrNext = (OSThread *)0;
+
+  /* The alarm follows the head */
+  if (OS_HrList == (OSThread *)0)
+  {
+    Gpt_HrStopAlarm();
+  }
+  else if (Link == &OS_HrList)
+  {
+    Gpt_HrStartAlarm(OS_HrList->HrWake);
+  }
 }
 
 
 /*----------------------------------------------------------------------------
-- @brief OS_OnStartup
--
-- @desc Sets the SysTick interrupt priority to the highest level.
--
+- @brief OS_HrAlarm
+
+- @desc Called by the alarm interrupt of the microsecond counter: moves
+        the threads whose wakeup time has been reached into the ready set
+        and re-arms the alarm for the next one. Runs at the kernel ceiling
+        like OS_Tick; the caller runs OS_Sched afterwards.
+
 - @param void
+
 - @return void
 -----------------------------------------------------------------------------*/
-void OS_OnStartup(void)
+MCU_RAMFUNC void OS_HrAlarm(void)
 {
-  /* Set the SysTick interrupt priority (highest) */
-  NVIC_SetPriority(SysTick_IRQn, 0U);
+  const uint32_t Now    = Gpt_HrGetTime();
+  OSThread      *Thread = OS_HrList;
+
+  while ((Thread != (OSThread *)0) && ((int32_t)(Thread->HrWake - Now) <= 0))
+  {
+    OSThread *Next = Thread->HrNext;
+
+    Thread->HrNext = (OSThread *)0;
+
+    OS_ReadyInsert(Thread);
+
+    Thread = Next;
+  }
+
+  OS_HrList = Thread;
+
+  if (Thread != (OSThread *)0)
+  {
+    Gpt_HrStartAlarm(Thread->HrWake);
+  }
+  else
+  {
+    Gpt_HrStopAlarm();
+  }
 }
+#endif
 
 
 /*----------------------------------------------------------------------------
-- @brief OSThread_Start
+- @brief OSPeriodic_Init
 
-- @desc  Initializes a threads stack and TCB, pre-fills stack for debugging,
-         and marks the thread as ready to run in the OS.
+- @desc Anchors a periodic activation at the current tick: the following
+        activations are on exact multiples of Period from here.
 
-- @param TCB  Thread   : Control block pointer
-         Prio Thread   : Priority
-         ThreadHandler : Entry function for the thread
-         StkStorage    : Stack memory base address
-         StkSize       : Stack size
+- @param Periodic  Periodic activation
+         Period    Period in ticks (> 0)
 
 - @return void
 -----------------------------------------------------------------------------*/
-void OSThread_Start(OSThread *TCB, uint8_t Prio, OSThreadHandler ThreadHandler, void *StkStorage, uint32_t StkSize)
+void OSPeriodic_Init(OSPeriodic *Periodic, uint32_t Period)
 {
-  /* round down the stack top to the 8-byte boundary
-  * NOTE: ARM Cortex-M stack grows down from hi -> low memory
-  */
-  uint32_t *StckPointer = (uint32_t *)((((uint32_t)StkStorage + StkSize) / 8) * 8);
-
-  uint32_t *StckLimit;
-
-  /* Initialize Cortex-M exception stack frame (automatically saved on exception entry) */
-  *(--StckPointer) = (1U << 24);              /* xPSR */
-  *(--StckPointer) = (uint32_t)ThreadHandler; /* PC   */
-  *(--StckPointer) = 0x0000000EU;             /* LR   */
-  *(--StckPointer) = 0x0000000CU;             /* R12  */
-  *(--StckPointer) = 0x00000003U;             /* R3   */
-  *(--StckPointer) = 0x00000002U;             /* R2   */
-  *(--StckPointer) = 0x00000001U;             /* R1   */
-  *(--StckPointer) = 0x00000000U;             /* R0   */
-  /* additionally, fake registers R4-R11     */
-  *(--StckPointer) = 0x0000000BU;             /* R11  */
-  *(--StckPointer) = 0x0000000AU;             /* R10  */
-  *(--StckPointer) = 0x00000009U;             /* R9   */
-  *(--StckPointer) = 0x00000008U;             /* R8   */
-  *(--StckPointer) = 0x00000007U;             /* R7   */
-  *(--StckPointer) = 0x00000006U;             /* R6   */
-  *(--StckPointer) = 0x00000005U;             /* R5   */
-  *(--StckPointer) = 0x00000004U;             /* R4   */
-
-  /* Save top of stack pointer in TCB */
-  TCB->MyStckPointer = StckPointer;
+  Periodic->Period   = Period;
+  Periodic->NextWake = OS_TickCount;
+  Periodic->Overruns = 0U;
+}
 
-  /* Round bottom of stack up to 8-byte boundary for pre-fill */
-  StckLimit = (uint32_t *)(((((uint32_t)StkStorage - 1U) / 8U) + 1U) * 8U);
 
-  /* Pre-fill unused stack space with a known pattern for debugging */
-  for (StckPointer = StckPointer - 1U; StckPointer >= StckLimit; --StckPointer)
+/*----------------------------------------------------------------------------
+- @brief OSPeriodic_Wait
+
+- @desc Blocks until the next activation. The wakeups stay on multiples
+        of the period, whatever the run time of the loop body. If the
+        body overran one or more activations, they are skipped and the
+        thread waits for the next one still ahead; the count is returned
+        and added to Overruns.
+
+- @param Periodic  Periodic activation
+
+- @return uint32_t  Activations missed since the previous call (0: on time)
+-----------------------------------------------------------------------------*/
+uint32_t OSPeriodic_Wait(OSPeriodic *Periodic)
+{
+  uint32_t Missed = 0U;
+
+  Periodic->NextWake += Periodic->Period;
+
+  while (OS_DelayUntil(Periodic->NextWake) == OS_TIMEOUT)
   {
-    *StckPointer = 0xFACEB00CUL;
+    Periodic->NextWake += Periodic->Period;
+    ++Missed;
   }
 
-  /* Register thread with the OS */
-  OS_Thread[Prio] = TCB;
-  TCB->Prio       = Prio;
+  Periodic->Overruns += Missed;
 
-  /* Make thread ready to run (except priority 0, reserved for idle) */
-  if(Prio > 0U)
+  return Missed;
+}
+
+/*----------------------------------------------------------------------------
+- @brief OS_DelayInsert
+
+- @desc Inserts a thread into the delta list of delayed threads. Each
+        TimeOut holds the ticks remaining after its predecessor expires,
+        so the list is ordered by absolute deadline. The walk is done
+        here, in thread context, to keep OS_Tick constant-time. A zero
+        delay is taken as one tick (the next tick), so the head never
+        holds a zero delta that OS_Tick would not decrement.
+        Must be called in a critical section.
+
+- @param Thread  Thread to delay
+         Ticks   Delay duration in system ticks (0 is taken as 1)
+
+- @return void
+-----------------------------------------------------------------------------*/
+static void OS_DelayInsert(OSThread *Thread, uint32_t Ticks)
+{
+  OSThread *Prev = (OSThread *)0;
+  OSThread *Next = OS_DelayedList;
+
+  Ticks = (Ticks != 0U) ? Ticks : 1U;
+
+  /* Skip the threads that expire before (or together with) this one */
+  while ((Next != (OSThread *)0) && (Next->TimeOut <= Ticks))
+  {
+    Ticks -= Next->TimeOut;
+    Prev   = Next;
+    Next   = Next->DlyNext;
+  }
+
+  Thread->TimeOut = Ticks;
+  Thread->DlyNext = Next;
+  Thread->DlyPrev = Prev;
+
+  /* The successor now expires relative to the inserted thread */
+  if (Next != (OSThread *)0)
   {
-    OS_ReadySet |= (1U << (Prio - 1U));
+    Next->TimeOut -= Ticks;
+    Next->DlyPrev  = Thread;
   }
 
+  if (Prev != (OSThread *)0)
+  {
+    Prev->DlyNext  = Thread;
+  }
+  else
+  {
+    OS_DelayedList = Thread;
+  }
 }
 
 
 /*----------------------------------------------------------------------------
-- @brief PendSV_Handler
+- @brief OS_DelayRemove
 
-- @desc Performs RTOS context switching: saves current thread state,
-        restores next thread state, and updates OS_Curr pointer.
+- @desc Removes a thread from the delayed list before its timeout expired
+        (e.g. woken by a post). Its remaining delta is handed over to the
+        successor. Does nothing if the thread is not delayed.
+        Must be called in a critical section.
 
-- @param void
+- @param Thread  Thread to remove
 
 - @return void
 -----------------------------------------------------------------------------*/
-__attribute__ ((naked)) void PendSV_Handler(void)
+MCU_RAMFUNC static void OS_DelayRemove(OSThread *Thread)
 {
-  __asm volatile
-  (
-           /* Disable_Irq(); */
-    "  CPSID         I                  \n"
+  if ((Thread->DlyPrev == (OSThread *)0) && (OS_DelayedList != Thread))
+  {
+    return;
+  }
+
+  if (Thread->DlyNext != (OSThread *)0)
+  {
+    Thread->DlyNext->TimeOut += Thread->TimeOut;
+    Thread->DlyNext->DlyPrev  = Thread->DlyPrev;
+  }
+
+  if (Thread->DlyPrev != (OSThread *)0)
+  {
+    Thread->DlyPrev->DlyNext  = Thread->DlyNext;
+  }
+  else
+  {
+    OS_DelayedList = Thread->DlyNext;
+  }
 
-    /* if (OS_curr != (OSThread *)0) { */
-    "  LDR           r1,=OS_Curr      \n"
-    "  LDR           r1,[r1,#0x00]    \n"
-    "  CMP           r1,#0            \n"
-    "  BEQ           PendSV_restore   \n"
+  Thread->DlyNext = (OSThread *)0;
+  Thread->DlyPrev = (OSThread *)0;
+}
 
-    /* push registers r4-r11 on the stack  */
-    "  PUSH          {r4-r11}           \n"
 
-         /* OS_curr->sp = sp; */
-    "  LDR           r1,=OS_Curr      \n"
-    "  LDR           r1,[r1,#0x00]    \n"
-    "  MOV           r0,sp            \n"
-    "  STR           r0,[r1,#0x00]    \n"
+/*----------------------------------------------------------------------------
+- @brief OS_Tick
 
-                /* } */
-    "PendSV_restore:                  \n"
+- @desc Updates delayed threads each system tick, moves threads whose
+        timeouts expire into the ready set. Only the head of the delta
+        list is decremented, so the cost does not depend on the number
+        of delayed threads (apart from the threads expiring this tick).
+        Then charges the tick to the time slice of the running thread:
+        once used up, its ready list is rotated so that the next thread
+        of the same priority runs after the following OS_Sched().
 
-        /* sp = OS_next->sp; */
-    "  LDR           r1,=OS_Next      \n"
-    "  LDR           r1,[r1,#0x00]    \n"
-    "  LDR           r0,[r1,#0x00]    \n"
-    "  MOV           sp,r0            \n"
+- @param void
 
-        /* OS_curr = OS_next; */
-    "  LDR           r1,=OS_Next     \n"
-    "  LDR           r1,[r1,#0x00]   \n"
-    "  LDR           r2,=OS_Curr     \n"
-    "  STR           r1,[r2,#0x00]   \n"
+- @return void
+-----------------------------------------------------------------------------*/
+MCU_RAMFUNC void OS_Tick(void)
+{
+  OSThread *Thread = OS_DelayedList;
+  OSThread *Curr   = OS_Curr;
 
-       /* pop registers r4-r11 */
-    "  POP           {r4-r11}        \n"
+  OS_TRACE(OS_TRACE_TICK, 0U);
 
-         /* Enable_Irq(); */
-    "  CPSIE         I               \n"
+  ++OS_TickCount;
 
-       /* return to the next thread */
-    "  BX            lr              \n"
-  );
+#if (OS_CFG_THREAD_STATS == 1)
+  /* Account the running thread at least once per tick, long before
+     the 32-bit DWT_CYCCNT wraps around */
+  OS_StatsAccount();
+#endif
+
+  if (Thread != (OSThread *)0)
+  {
+    /* Decrement the nearest timeout (the head delta is never zero) */
+    --Thread->TimeOut;
+
+    /* Timeout expired: move all threads with a zero delta to ready set */
+    while ((Thread != (OSThread *)0) && (Thread->TimeOut == 0U))
+    {
+      OSThread *Next = Thread->DlyNext;
+
+      Thread->DlyNext = (OSThread *)0;
+      Thread->DlyPrev = (OSThread *)0;
+
+      /* A timed pend expired: leave the wait set of the object */
+      if (Thread->PendSet != (OSPrioSet *)0)
+      {
+        OS_WaitRemove(Thread);
+        Thread->PendStatus  = OS_TIMEOUT;
+      }
+
+      OS_ReadyInsert(Thread);
+
+      Thread = Next;
+    }
+
+    OS_DelayedList = Thread;
+
+    if (Thread != (OSThread *)0)
+    {
+      Thread->DlyPrev = (OSThread *)0;
+    }
+  }
+
+#if (OS_CFG_TIMERS == 1)
+  /* Software timers: wakes the timer thread on expiry */
+  OS_TimerTick();
+#endif
+
+  /* Round robin among the ready threads of the running thread's level */
+  if (   (Curr != (OSThread *)0)
+      && (Curr->TimeSlice != 0U)
+      && (OS_ReadyList[Curr->Prio] == Curr)
+      && (Curr->RdyNext != Curr))
+  {
+    if (--Curr->SliceLeft == 0U)
+    {
+      Curr->SliceLeft            = Curr->TimeSlice;
+      OS_ReadyList[Curr->Prio]   = Curr->RdyNext;
+    }
+  }
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_IsReady
+
+- @desc Tells whether a thread is ready to run, i.e. linked into the
+        ready list of its priority level. Must be called with interrupts
+        DISABLED.
+
+- @param Thread  Thread to check
+
+- @return bool   true if the thread is ready
+-----------------------------------------------------------------------------*/
+static bool OS_IsReady(const OSThread *Thread)
+{
+  return (Thread->RdyNext != (OSThread *)0);
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_ReadyInsert / OS_ReadyRemove
+
+- @desc Link a thread into or out of the circular ready list of its
+        priority level. A thread made ready is appended behind the
+        threads already waiting for their turn and gets a full time
+        slice. The ready bit of a level is set while its list is not
+        empty; removing the head passes the turn on to its successor.
+        Must be called in a critical section.
+
+- @param Thread  Thread made ready / blocked
+
+- @return void
+-----------------------------------------------------------------------------*/
+MCU_RAMFUNC static void OS_ReadyInsert(OSThread *Thread)
+{
+  OSThread *Head = OS_ReadyList[Thread->Prio];
+
+  OS_TRACE(OS_TRACE_READY, Thread->TraceId);
+
+  Thread->SliceLeft = Thread->TimeSlice;
+
+  if (Head == (OSThread *)0)
+  {
+    Thread->RdyNext = Thread;
+    Thread->RdyPrev = Thread;
+
+    OS_ReadyList[Thread->Prio] = Thread;
+    OS_PrioSetAdd(&OS_ReadySet, Thread->Prio);
+  }
+  else
+  {
+    /* The tail is the predecessor of the head */
+    Thread->RdyNext        = Head;
+    Thread->RdyPrev        = Head->RdyPrev;
+    Head->RdyPrev->RdyNext = Thread;
+    Head->RdyPrev          = Thread;
+  }
+}
+
+static void OS_ReadyRemove(OSThread *Thread)
+{
+  if (Thread->RdyNext == (OSThread *)0)
+  {
+    return;
+  }
+
+  if (Thread->RdyNext == Thread)
+  {
+    OS_ReadyList[Thread->Prio] = (OSThread *)0;
+    OS_PrioSetRemove(&OS_ReadySet, Thread->Prio);
+  }
+  else
+  {
+    Thread->RdyPrev->RdyNext = Thread->RdyNext;
+    Thread->RdyNext->RdyPrev = Thread->RdyPrev;
+
+    if (OS_ReadyList[Thread->Prio] == Thread)
+    {
+      OS_ReadyList[Thread->Prio] = Thread->RdyNext;
+    }
+  }
+
+  Thread->RdyNext = (OSThread *)0;
+  Thread->RdyPrev = (OSThread *)0;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_PrioLink / OS_PrioUnlink
+
+- @desc Add a thread to or remove it from the threads of its priority
+        level in OS_Thread[], in start order. The wait set lookups walk
+        these lists. Must be called in a critical section.
+
+- @param Thread  Thread to link / unlink
+
+- @return void
+-----------------------------------------------------------------------------*/
+static void OS_PrioLink(OSThread *Thread)
+{
+  OSThread **Link = &OS_Thread[Thread->Prio];
+
+  while (*Link != (OSThread *)0)
+  {
+    Link = &(*Link)->PrioNext;
+  }
+
+  Thread->PrioNext = (OSThread *)0;
+  *Link            = Thread;
+}
+
+static void OS_PrioUnlink(OSThread *Thread)
+{
+  OSThread **Link = &OS_Thread[Thread->Prio];
+
+  while ((*Link != (OSThread *)0) && (*Link != Thread))
+  {
+    Link = &(*Link)->PrioNext;
+  }
+
+  if (*Link != (OSThread *)0)
+  {
+    *Link = Thread->PrioNext;
+  }
+
+  Thread->PrioNext = (OSThread *)0;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_PendCurr
+
+- @desc Blocks the current thread on the wait set of an OS object: removes
+        it from OS_ReadySet, sets its priority bit in the wait set and, for
+        a finite timeout, inserts it into the delayed list. The caller
+        triggers OS_Sched() and the switch happens when interrupts are
+        enabled again; the result is then in OS_Curr->PendStatus.
+        Must be called in a critical section.
+
+- @param WaitSet  Waiter bitmask of the OS object
+         Ticks    Timeout in system ticks or OS_WAIT_FOREVER
+
+- @return void
+-----------------------------------------------------------------------------*/
+void OS_PendCurr(OSPrioSet *WaitSet, uint32_t Ticks)
+{
+  OS_TRACE(OS_TRACE_PEND, OS_Curr->TraceId);
+
+  OS_Curr->PendSet    = WaitSet;
+  OS_Curr->PendStatus = OS_OK;
+
+  OS_PrioSetAdd(WaitSet, OS_Curr->Prio);
+
+  if (Ticks != OS_WAIT_FOREVER)
+  {
+    OS_DelayInsert(OS_Curr, Ticks);
+  }
+
+  OS_ReadyRemove(OS_Curr);
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_WaitRemove
+
+- @desc Takes a pending thread out of the wait set of its object. The bit
+        of its priority level stays set while another thread of the same
+        level still pends on the object.
+        Must be called in a critical section.
+
+- @param Thread  Pending thread
+
+- @return void
+-----------------------------------------------------------------------------*/
+MCU_RAMFUNC static void OS_WaitRemove(OSThread *Thread)
+{
+  OSPrioSet      *WaitSet = Thread->PendSet;
+  const OSThread *Peer    = OS_Thread[Thread->Prio];
+
+  Thread->PendSet = (OSPrioSet *)0;
+
+  while ((Peer != (OSThread *)0) && (Peer->PendSet != WaitSet))
+  {
+    Peer = Peer->PrioNext;
+  }
+
+  if (Peer == (OSThread *)0)
+  {
+    OS_PrioSetRemove(WaitSet, Thread->Prio);
+  }
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_NextWaiter
+
+- @desc Iterates the threads pending on an object, highest priority
+        first (threads of one level in start order). The level is found
+        from the wait set, then the threads of that level are
+        searched for the object. Waking the returned thread does not
+        break the iteration.
+        Must be called in a critical section.
+
+- @param WaitSet  Waiter bitmask of the OS object
+         Thread   Waiter returned by the previous call, null for the first
+
+- @return OSThread*  Next pending thread, null if there is none
+-----------------------------------------------------------------------------*/
+MCU_RAMFUNC OSThread *OS_NextWaiter(const OSPrioSet *WaitSet, const OSThread *Thread)
+{
+  uint32_t  Prio = OS_CFG_MAX_PRIO + 1U;
+  OSThread *Next = (OSThread *)0;
+
+  if (Thread != (OSThread *)0)
+  {
+    /* Continue at the same level, then with the lower ones */
+    Prio = Thread->Prio;
+    Next = Thread->PrioNext;
+  }
+
+  for (;;)
+  {
+    while (Next != (OSThread *)0)
+    {
+      if (Next->PendSet == WaitSet)
+      {
+        return Next;
+      }
+
+      Next = Next->PrioNext;
+    }
+
+    Prio = OS_PrioSetHighestBelow(WaitSet, Prio);
+
+    if (Prio == 0U)
+    {
+      return (OSThread *)0;
+    }
+
+    Next = OS_Thread[Prio];
+  }
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_PrioSetHighestBelow
+
+- @desc Returns the highest priority of a set that is lower than a given
+        priority (used to iterate a wait set level by level).
+
+- @param Set   Priority set
+         Prio  Upper bound (exclusive), up to OS_CFG_MAX_PRIO + 1
+
+- @return uint32_t  Highest priority below Prio, 0 if there is none
+-----------------------------------------------------------------------------*/
+MCU_RAMFUNC static uint32_t OS_PrioSetHighestBelow(const OSPrioSet *Set, uint32_t Prio)
+{
+  /* Bits of the levels 1 .. Prio-1 in the word of level Prio */
+  const uint32_t Below = OS_PRIO_BIT(Prio) - 1U;
+
+#if (OS_CFG_MAX_PRIO <= 32)
+  const uint32_t Bits  = (Prio > 32U) ? *Set : (*Set & Below);
+
+  return (Bits != 0U) ? OS_LOG2(Bits) : 0U;
+#else
+  uint32_t Group = OS_PRIO_GROUP(Prio);
+  uint32_t Bits;
+
+  if (Group < OS_PRIO_GROUPS)
+  {
+    Bits = Set->Level[Group] & Below;
+
+    if (Bits != 0U)
+    {
+      return (Group * 32U) + OS_LOG2(Bits);
+    }
+  }
+
+  /* Continue with the highest lower group */
+  Bits = Set->Group & (((uint32_t)1U << Group) - 1U);
+
+  if (Bits == 0U)
+  {
+    return 0U;
+  }
+
+  Group = OS_LOG2(Bits) - 1U;
+
+  return (Group * 32U) + OS_LOG2(Set->Level[Group]);
+#endif
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_WakeThread
+
+- @desc Wakes a thread pending on an OS object: removes it from the wait
+        set, cancels its timeout and makes it ready. The caller triggers
+        OS_Sched(). Must be called in a critical section.
+
+- @param Thread   Pending thread
+
+- @return void
+-----------------------------------------------------------------------------*/
+MCU_RAMFUNC void OS_WakeThread(OSThread *Thread)
+{
+  OS_WaitRemove(Thread);
+  Thread->PendStatus = OS_OK;
+
+  OS_DelayRemove(Thread);
+  OS_ReadyInsert(Thread);
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_WakeHighest
+
+- @desc Wakes the highest-priority thread of a non-empty wait set.
+        Must be called in a critical section.
+
+- @param WaitSet  Waiter bitmask of the OS object (must not be 0)
+
+- @return OSThread*  The thread that was woken
+-----------------------------------------------------------------------------*/
+MCU_RAMFUNC OSThread *OS_WakeHighest(OSPrioSet *WaitSet)
+{
+  OSThread *Thread = OS_NextWaiter(WaitSet, (OSThread *)0);
+
+  OS_WakeThread(Thread);
+
+  return Thread;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_SetPrio
+
+- @desc Changes the effective priority of a thread (priority inheritance).
+        The thread moves to the threads of the new level; a ready thread
+        is appended to the new ready list and a pending thread keeps
+        pending on its object at the new level.
+        Must be called in a critical section.
+
+- @param Thread  Thread whose priority changes
+         Prio    New effective priority (BasePrio to restore)
+
+- @return void
+-----------------------------------------------------------------------------*/
+void OS_SetPrio(OSThread *Thread, uint8_t Prio)
+{
+  OSPrioSet *PendSet = Thread->PendSet;
+  const bool Ready   = OS_IsReady(Thread);
+
+  /* Leave the old level */
+  OS_ReadyRemove(Thread);
+
+  if (PendSet != (OSPrioSet *)0)
+  {
+    OS_WaitRemove(Thread);
+  }
+
+  OS_PrioUnlink(Thread);
+
+  /* Join the new level */
+  Thread->Prio = Prio;
+
+  OS_PrioLink(Thread);
+
+  if (PendSet != (OSPrioSet *)0)
+  {
+    Thread->PendSet = PendSet;
+    OS_PrioSetAdd(PendSet, Prio);
+  }
+
+  if (Ready)
+  {
+    OS_ReadyInsert(Thread);
+  }
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_Run
+
+- @desc Starts the interrupts (OS_OnStartup), enables scheduling and
+        switches to the highest-priority ready thread.
+
+- @param void
+
+- @return void
+-----------------------------------------------------------------------------*/
+void OS_Run(void)
+{
+  OSCritical Crit;
+
+  /* callback to configure and start interrupts */
+  OS_OnStartup();
+
+  /* Boot time: reset to the first thread dispatch */
+  OS_BootCycles = DWT_CYCCNT;
+
+  OS_CRITICAL_ENTER(Crit);
+  OS_Running = true;
+  OS_Sched();
+  OS_CRITICAL_EXIT(Crit);
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_OnStartup
+-
+- @desc Sets the SysTick interrupt priority to the kernel ceiling
+-       (OS_CFG_KERNEL_IRQ_PRIO), so that the context switch can mask it.
+-       With OS_CFG_HR_TIME, starts the microsecond counter.
+-
+- @param void
+- @return void
+-----------------------------------------------------------------------------*/
+void OS_OnStartup(void)
+{
+  /* Set the SysTick interrupt priority (kernel ceiling) */
+  NVIC_SetPriority(SysTick_IRQn, (uint32_t)OS_CFG_KERNEL_IRQ_PRIO);
+
+#if (OS_CFG_HR_TIME == 1)
+  /* Start the microsecond counter, its alarm runs at the kernel ceiling */
+  Gpt_HrInit();
+#endif
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSThread_Start
+
+- @desc  Initializes a threads stack and TCB, pre-fills stack for debugging,
+         and marks the thread as ready to run in the OS. May also be called
+         at runtime, e.g. with a TCB and stack allocated from an OSPool.
+
+- @param TCB  Thread   : Control block pointer
+         Prio Thread   : Priority
+         ThreadHandler : Entry function for the thread
+         StkStorage    : Stack memory base address
+         StkSize       : Stack size
+
+- @return void
+-----------------------------------------------------------------------------*/
+void OSThread_Start(OSThread *TCB, uint8_t Prio, OSThreadHandler ThreadHandler, void *StkStorage, uint32_t StkSize)
+{
+  /* round down the stack top to the 8-byte boundary
+  * NOTE: ARM Cortex-M stack grows down from hi -> low memory
+  */
+  uint32_t *const StckTop   = (uint32_t *)((((uintptr_t)StkStorage + StkSize) / 8U) * 8U);
+
+  /* Round bottom of stack up to 8-byte boundary for pre-fill */
+  uint32_t *const StckLimit = (uint32_t *)(((((uintptr_t)StkStorage - 1U) / 8U) + 1U) * 8U);
+
+#if (OS_CFG_STACK_FILL == 1)
+  uint32_t *StckPointer;
+#endif
+  OSCritical Crit;
+
+#if (OS_CFG_STACK_FILL == 1)
+  /* Pre-fill the stack with a known pattern for debugging: both ends are
+     8-byte aligned, so two words per pass */
+  for (StckPointer = StckLimit; StckPointer < StckTop; StckPointer += 2U)
+  {
+    StckPointer[0U] = OS_STACK_FILL;
+    StckPointer[1U] = OS_STACK_FILL;
+  }
+#else
+  /* Only the guard word checked by PendSV_Handler (OS_CFG_STACK_CHECK) */
+  *StckLimit = OS_STACK_FILL;
+#endif
+
+  /* Keep the bounds for the high-water mark and the overflow check */
+  TCB->StkLimit = StckLimit;
+  TCB->StkSize  = (uint32_t)(StckTop - StckLimit) * sizeof(uint32_t);
+
+  /* Initial context (e.g. exception stack frame) of the port */
+  OSPort_StackInit(TCB, ThreadHandler, &OSThread_Exit, StckTop);
+
+  /* Register thread with the OS */
+  OS_CRITICAL_ENTER(Crit);
+
+  TCB->Prio       = Prio;
+  TCB->BasePrio   = Prio;
+  TCB->MutexList  = (struct OSMutex_tag *)0;
+  TCB->PendMutex  = (struct OSMutex_tag *)0;
+  TCB->DlyNext    = (OSThread *)0;
+  TCB->DlyPrev    = (OSThread *)0;
+  TCB->PendSet    = (OSPrioSet *)0;
+  TCB->RdyNext    = (OSThread *)0;
+  TCB->RdyPrev    = (OSThread *)0;
+  TCB->TimeSlice  = OS_CFG_TIME_SLICE;
+
+#if (OS_CFG_HR_TIME == 1)
+  TCB->HrNext     = (OSThread *)0;
+#endif
+
+#if (OS_CFG_THREAD_STATS == 1)
+  TCB->RunCycles  = 0U;
+  TCB->Switches   = 0U;
+#endif
+
+#if (OS_CFG_TRACE == 1)
+  TCB->TraceId    = OS_TraceNextId++;
+#endif
+
+  /* Several threads may share a priority level */
+  OS_PrioLink(TCB);
+
+  /* Make thread ready to run (except priority 0, reserved for idle) */
+  if(Prio > 0U)
+  {
+    OS_ReadyInsert(TCB);
+  }
+
+  /* A thread started at runtime may preempt the caller */
+  if(OS_Curr != (OSThread *)0)
+  {
+    OS_Sched();
+  }
+
+  OS_CRITICAL_EXIT(Crit);
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSThread_Stop
+
+- @desc  Removes a thread from the OS: cancels its delay or pend and
+         unlinks it from its priority level. Its TCB and stack may then be reused (e.g.
+         returned to an OSPool) by another thread. A thread may stop
+         itself; it must not hold a mutex.
+
+- @param TCB  Thread to stop (not the idle thread)
+
+- @return void
+-----------------------------------------------------------------------------*/
+void OSThread_Stop(OSThread *TCB)
+{
+  OSCritical Crit;
+
+  OS_CRITICAL_ENTER(Crit);
+
+  OS_DelayRemove(TCB);
+
+#if (OS_CFG_HR_TIME == 1)
+  OS_HrRemove(TCB);
+#endif
+
+  if (TCB->PendSet != (OSPrioSet *)0)
+  {
+    OS_WaitRemove(TCB);
+  }
+
+  OS_ReadyRemove(TCB);
+  OS_PrioUnlink(TCB);
+
+  /* Switches away if the thread stopped itself */
+  OS_Sched();
+
+  OS_CRITICAL_EXIT(Crit);
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSThread_SetTimeSlice
+
+- @desc  Sets the number of ticks a thread may run before the next ready
+         thread of the same priority gets its turn (OS_CFG_TIME_SLICE by
+         default). 0 lets the thread run until it blocks.
+
+- @param TCB    Thread
+         Ticks  Time slice in system ticks, 0 to disable round robin
+
+- @return void
+-----------------------------------------------------------------------------*/
+void OSThread_SetTimeSlice(OSThread *TCB, uint32_t Ticks)
+{
+  OSCritical Crit;
+
+  OS_CRITICAL_ENTER(Crit);
+
+  TCB->TimeSlice = Ticks;
+  TCB->SliceLeft = Ticks;
+
+  OS_CRITICAL_EXIT(Crit);
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSThread_StackHighWater
+
+- @desc  Returns the peak stack usage of a thread so far: the pre-filled
+         pattern is scanned from the bottom of the stack up to the first
+         overwritten word. Stack size minus the high-water mark is the
+         margin left. The scan reads the stack without locking; it may be
+         called from any thread. Without OS_CFG_STACK_FILL the usage is
+         unknown and the whole stack is reported.
+
+- @param TCB  Thread
+
+- @return uint32_t  Peak stack usage in bytes
+-----------------------------------------------------------------------------*/
+uint32_t OSThread_StackHighWater(const OSThread *TCB)
+{
+#if (OS_CFG_STACK_FILL == 1)
+  const uint32_t *Word = TCB->StkLimit;
+  const uint32_t *Top  = TCB->StkLimit + (TCB->StkSize / sizeof(uint32_t));
+
+  while ((Word < Top) && (*Word == OS_STACK_FILL))
+  {
+    ++Word;
+  }
+
+  return (uint32_t)(Top - Word) * sizeof(uint32_t);
+#else
+  return TCB->StkSize;
+#endif
+}
+
+
+#if (OS_CFG_THREAD_STATS == 1)
+/*----------------------------------------------------------------------------
+- @brief OS_StatsAccount
+
+- @desc  Adds the DWT cycles since the last accounting to the running
+         thread and to the total. Must be called in a critical section
+         (or from PendSV_Handler/SysTick_Handler).
+
+- @param void
+
+- @return void
+-----------------------------------------------------------------------------*/
+MCU_RAMFUNC static void OS_StatsAccount(void)
+{
+  const uint32_t Now = DWT_CYCCNT;
+
+  if (OS_Curr != (OSThread *)0)
+  {
+    const uint32_t Cycles = Now - OS_StatsStamp;
+
+    OS_Curr->RunCycles += Cycles;
+    OS_StatsTotal      += Cycles;
+  }
+
+  OS_StatsStamp = Now;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_StatsSwitch
+
+- @desc  Called by PendSV_Handler before OS_Curr becomes OS_Next: closes
+         the run time of the outgoing thread and counts the switch of the
+         incoming one.
+
+- @param void
+
+- @return void
+-----------------------------------------------------------------------------*/
+MCU_RAMFUNC void OS_StatsSwitch(void)
+{
+  OS_StatsAccount();
+
+  if (OS_Next != OS_Curr)
+  {
+    ++OS_Next->Switches;
+  }
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSThread_GetStats
+
+- @desc  Returns the DWT cycles a thread has run since it was started,
+         including the cycles of the interrupts taken while it ran and
+         its current time slice, and the number of times it was switched
+         in.
+
+- @param TCB    Thread
+         Stats  Destination of the statistics
+
+- @return void
+-----------------------------------------------------------------------------*/
+void OSThread_GetStats(const OSThread *TCB, OSThreadStats *Stats)
+{
+  OSCritical Crit;
+
+  OS_CRITICAL_ENTER(Crit);
+
+  OS_StatsAccount();
+
+  Stats->RunCycles = TCB->RunCycles;
+  Stats->Switches  = TCB->Switches;
+
+  OS_CRITICAL_EXIT(Crit);
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_GetTotalCycles
+
+- @desc  Returns the DWT cycles accounted to all threads since the first
+         context switch; the reference for the load of a thread.
+
+- @param void
+
+- @return uint64_t  Total cycles
+-----------------------------------------------------------------------------*/
+uint64_t OS_GetTotalCycles(void)
+{
+  uint64_t Total;
+  OSCritical Crit;
+
+  OS_CRITICAL_ENTER(Crit);
+
+  OS_StatsAccount();
+  Total = OS_StatsTotal;
+
+  OS_CRITICAL_EXIT(Crit);
+
+  return Total;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_GetIdlePercent
+
+- @desc  Returns the share of the idle thread in the total cycles since
+         the first context switch. The CPU load is 100 minus this value;
+         the load over a window follows from two OS_GetTotalCycles and
+         OSThread_GetStats snapshots.
+
+- @param void
+
+- @return uint32_t  Idle share in percent (0 .. 100)
+-----------------------------------------------------------------------------*/
+uint32_t OS_GetIdlePercent(void)
+{
+  uint64_t Idle;
+  uint64_t Total;
+  OSCritical Crit;
+
+  OS_CRITICAL_ENTER(Crit);
+
+  OS_StatsAccount();
+  Idle  = IdleThread.RunCycles;
+  Total = OS_StatsTotal;
+
+  OS_CRITICAL_EXIT(Crit);
+
+  return (Total != 0U) ? (uint32_t)((Idle * 100U) / Total) : 0U;
+}
+#endif
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_OnStackOverflow
+
+- @desc  Called from PendSV_Handler with OS_CFG_STACK_CHECK when the thread
+         being switched out has run past its stack limit or overwritten
+         its lowest stack word. Memory below the stack may be corrupted,
+         so the hook must not return (e.g. log and reset). The default
+         stops the system; the application may override it.
+
+- @param Thread  Thread whose stack overflowed
+
+- @return void
+-----------------------------------------------------------------------------*/
+__attribute__((weak)) void OS_OnStackOverflow(OSThread *Thread)
+{
+  (void) Thread;
+
+  Disable_Irq();
+
+  for(;;)
+  {
+    ;
+  }
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSThread_Exit
+
+- @desc  Return address of every thread: a thread handler that returns is
+         stopped instead of running into an invalid address.
+
+- @param void
+
+- @return void
+-----------------------------------------------------------------------------*/
+static void OSThread_Exit(void)
+{
+  OSThread_Stop(OS_Curr);
+
+  for(;;)
+  {
+    /* Never reached: the thread is no longer scheduled */
+    ;
+  }
 }
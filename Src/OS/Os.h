@@ -1,25 +1,255 @@
 #ifndef OS_2025_08_02_H
   #define OS_2025_08_02_H
 
+  #include <stdbool.h>
   #include <stdint.h>
 
+  #include "OsCfg.h"
+
+  /* Special timeout values for blocking calls */
+  #define OS_NO_WAIT          (0UL)
+  #define OS_WAIT_FOREVER     (0xFFFFFFFFUL)
+
+  /* Result of blocking OS calls */
+  typedef enum
+  {
+    OS_OK = 0,                        /* Operation completed */
+    OS_TIMEOUT,                       /* Timeout expired (or resource not available with OS_NO_WAIT) */
+    OS_ERR_NOT_OWNER,                 /* Calling thread does not own the object */
+    OS_ERR_DEADLOCK,                  /* Calling thread already owns the object */
+    OS_ERR_FULL,                      /* Object has no room left */
+    OS_ERR_PARAM                      /* Invalid argument (e.g. zero size) */
+  } OSStatus;
+
+  /*----------------------------------------------------------------------------
+  - Kernel critical section
+  -
+  - Masks the interrupts up to the kernel ceiling OS_CFG_KERNEL_IRQ_PRIO
+  - (BASEPRI on the Cortex-M4); more urgent interrupts keep running and must
+  - not call the OS. Sections nest, Key keeps the previous mask:
+  -
+  -   OSCritical Key;
+  -   OS_CRITICAL_ENTER(Key);  ...  OS_CRITICAL_EXIT(Key);
+  -
+  - Mask_Irq and Restore_Irq are provided by Mcal/Mcu.h.
+  -----------------------------------------------------------------------------*/
+  typedef uint32_t OSCritical;
+
+  #define OS_CRITICAL_ENTER(Key)  ((Key) = Mask_Irq((uint32_t)OS_CFG_KERNEL_IRQ_PRIO))
+  #define OS_CRITICAL_EXIT(Key)   Restore_Irq(Key)
+
+  /*----------------------------------------------------------------------------
+  - Priority sets (ready set, wait sets of OS objects)
+  -
+  - Bit (Prio - 1) stands for a non-idle priority level. Up to 32 levels a
+  - set is a single word; above, a group word tells which of the 32-bit
+  - level words are not empty, so the highest priority still takes two CLZ.
+  -----------------------------------------------------------------------------*/
+  #define OS_LOG2(x)          (32U - (uint32_t)__builtin_clz(x))
+
+  #define OS_PRIO_BIT(Prio)   ((uint32_t)1U << (((uint32_t)(Prio) - 1U) % 32U))
+  #define OS_PRIO_GROUP(Prio) (((uint32_t)(Prio) - 1U) / 32U)
+  #define OS_PRIO_GROUPS      ((OS_CFG_MAX_PRIO + 31U) / 32U)
+
+  #if (OS_CFG_MAX_PRIO <= 32)
+    typedef uint32_t OSPrioSet;
+  #else
+    typedef struct
+    {
+      uint32_t Group;                   /* Bit g set while Level[g] is not 0 */
+      uint32_t Level[OS_PRIO_GROUPS];   /* Priorities 32*g+1 .. 32*g+32 */
+    } OSPrioSet;
+  #endif
+
+  /* Helpers of the scheduler hot path: inlined even at -O0 (no call out
+     of the RAM functions of MCU_CFG_RAMFUNC into flash) */
+  #define OS_INLINE           static inline __attribute__((always_inline))
+
+  /*----------------------------------------------------------------------------
+  - @brief OS_PrioSetInit / OS_PrioSetIsEmpty
+  -
+  - @desc Clears a priority set / tells whether it is empty.
+  -
+  - @param Set   Priority set
+  - @return bool true if no priority is set
+  -----------------------------------------------------------------------------*/
+  OS_INLINE void OS_PrioSetInit(OSPrioSet *Set)
+  {
+  #if (OS_CFG_MAX_PRIO <= 32)
+    *Set = 0U;
+  #else
+    uint32_t Group;
+
+    Set->Group = 0U;
+
+    for (Group = 0U; Group < OS_PRIO_GROUPS; ++Group)
+    {
+      Set->Level[Group] = 0U;
+    }
+  #endif
+  }
+
+  OS_INLINE bool OS_PrioSetIsEmpty(const OSPrioSet *Set)
+  {
+  #if (OS_CFG_MAX_PRIO <= 32)
+    return (*Set == 0U);
+  #else
+    return (Set->Group == 0U);
+  #endif
+  }
+
+
+  /*----------------------------------------------------------------------------
+  - @brief OS_PrioSetAdd / OS_PrioSetRemove
+  -
+  - @desc Sets / clears the bit of a (non-idle) priority level.
+  -
+  - @param Set   Priority set
+  -        Prio  Priority level (1 .. OS_CFG_MAX_PRIO)
+  - @return void
+  -----------------------------------------------------------------------------*/
+  OS_INLINE void OS_PrioSetAdd(OSPrioSet *Set, uint32_t Prio)
+  {
+  #if (OS_CFG_MAX_PRIO <= 32)
+    *Set |= OS_PRIO_BIT(Prio);
+  #else
+    Set->Level[OS_PRIO_GROUP(Prio)] |= OS_PRIO_BIT(Prio);
+    Set->Group                      |= ((uint32_t)1U << OS_PRIO_GROUP(Prio));
+  #endif
+  }
+
+  OS_INLINE void OS_PrioSetRemove(OSPrioSet *Set, uint32_t Prio)
+  {
+  #if (OS_CFG_MAX_PRIO <= 32)
+    *Set &= ~OS_PRIO_BIT(Prio);
+  #else
+    Set->Level[OS_PRIO_GROUP(Prio)] &= ~OS_PRIO_BIT(Prio);
+
+    if (Set->Level[OS_PRIO_GROUP(Prio)] == 0U)
+    {
+      Set->Group &= ~((uint32_t)1U << OS_PRIO_GROUP(Prio));
+    }
+  #endif
+  }
+
+
+  /*----------------------------------------------------------------------------
+  - @brief OS_PrioSetHighest
+  -
+  - @desc Returns the highest priority of a non-empty set.
+  -
+  - @param Set       Priority set (must not be empty)
+  - @return uint32_t  Highest priority level in the set
+  -----------------------------------------------------------------------------*/
+  OS_INLINE uint32_t OS_PrioSetHighest(const OSPrioSet *Set)
+  {
+  #if (OS_CFG_MAX_PRIO <= 32)
+    return OS_LOG2(*Set);
+  #else
+    const uint32_t Group = OS_LOG2(Set->Group) - 1U;
+
+    return (Group * 32U) + OS_LOG2(Set->Level[Group]);
+  #endif
+  }
+
+
   /* Thread Control Block (TCB) */
-  typedef struct
+  typedef struct OSThread_tag
   {
-    void     *MyStckPointer;  /* Stack pointer */
-    uint8_t  Prio;            /* Thread priority */
-    uint32_t TimeOut;         /* Timeout delay down-counter */
+    void     *MyStckPointer;          /* Stack pointer */
+    uint32_t ExcReturn;               /* EXC_RETURN of the thread (bit 4 clear: FPU context) */
+    uint32_t *StkLimit;               /* Lowest stack word (keeps the fill pattern unless overflowed) */
+    uint32_t StkSize;                 /* Stack size in bytes from StkLimit */
+    uint8_t  Prio;                    /* Effective thread priority */
+    uint8_t  BasePrio;                /* Assigned thread priority (without inheritance) */
+    struct OSMutex_tag *MutexList;    /* Mutexes held, their waiters set the inherited priority */
+    struct OSMutex_tag *PendMutex;    /* Mutex waited for (valid while PendSet is its wait set) */
+    uint32_t TimeOut;                 /* Ticks to expire after the previous delayed thread */
+    struct OSThread_tag *DlyNext;     /* Next thread in the delayed list */
+    struct OSThread_tag *DlyPrev;     /* Previous thread in the delayed list */
+    OSPrioSet *PendSet;               /* Wait set of the object the thread pends on */
+    OSStatus PendStatus;              /* Result of the last pend */
+    uint32_t PendValue;               /* Object specific pend argument/result (e.g. event flags) */
+    uint8_t  PendOpt;                 /* Object specific pend options */
+    void     *PendData;               /* Object handed over on wakeup (e.g. pool block) */
+    struct OSThread_tag *PrioNext;    /* Next thread started at the same priority level */
+    struct OSThread_tag *RdyNext;     /* Next thread in the ready list of the level */
+    struct OSThread_tag *RdyPrev;     /* Previous thread in the ready list of the level */
+    uint32_t TimeSlice;               /* Round-robin time slice in ticks (0: none) */
+    uint32_t SliceLeft;               /* Ticks left in the current time slice */
+  #if (OS_CFG_HR_TIME == 1)
+    uint32_t HrWake;                  /* Microsecond time to wake up at (OS_usDelayUntil) */
+    struct OSThread_tag *HrNext;      /* Next thread in the microsecond delay list */
+  #endif
+  #if (OS_CFG_THREAD_STATS == 1)
+    uint64_t RunCycles;               /* DWT cycles run (including interrupts taken meanwhile) */
+    uint32_t Switches;                /* Number of times the thread was switched in */
+  #endif
+  #if (OS_CFG_TRACE == 1)
+    uint8_t  TraceId;                 /* Thread id in trace events (start order, idle = 0) */
+  #endif
   } OSThread;
 
+  #if (OS_CFG_THREAD_STATS == 1)
+  /* Runtime statistics of a thread (OS_CFG_THREAD_STATS) */
+  typedef struct
+  {
+    uint64_t RunCycles;               /* DWT cycles the thread has run since it was started */
+    uint32_t Switches;                /* Number of times the thread was switched in */
+  } OSThreadStats;
+  #endif
+
+  /* Periodic activation of a thread on exact multiples of a period */
+  typedef struct
+  {
+    uint32_t Period;                  /* Period in ticks */
+    uint32_t NextWake;                /* Tick count of the next activation */
+    uint32_t Overruns;                /* Activations missed so far */
+  } OSPeriodic;
+
   typedef void (*OSThreadHandler)();
 
-  /* Initializes the operating system */
+  /*----------------------------------------------------------------------------
+  - Static thread definitions
+  -
+  - OS_THREAD_DEFINE(Name, Prio, Handler, StkBytes) declares the TCB
+  - Name_Thread and the stack Name_Stack at file scope and adds a constant
+  - entry to the thread table os_thread_def, collected in flash by the
+  - linker. OS_Init starts all threads of the table, so main() needs no
+  - OSThread_Start call for them. The priority and the stack size are
+  - checked at build time. Several threads may share a priority level
+  - (round robin). Needs Mcal/Mcu.h (MCU_THREAD_STACK).
+  -----------------------------------------------------------------------------*/
+  typedef struct
+  {
+    OSThread        *TCB;             /* Thread control block */
+    OSThreadHandler  Handler;         /* Entry function */
+    void            *StkStorage;      /* Stack memory base address */
+    uint32_t         StkSize;         /* Stack size in bytes */
+    uint8_t          Prio;            /* Thread priority (1 .. OS_CFG_MAX_PRIO) */
+  } OSThreadDef;
+
+  #define OS_THREAD_DEFINE(Name, Prio, Handler, StkBytes)                                  \
+    _Static_assert(((Prio) >= 1U) && ((Prio) <= OS_CFG_MAX_PRIO),                          \
+                   #Name ": priority must be 1 .. OS_CFG_MAX_PRIO");                       \
+    _Static_assert((StkBytes) >= OS_CFG_THREAD_STACK_MIN,                                  \
+                   #Name ": stack smaller than OS_CFG_THREAD_STACK_MIN");                  \
+    _Static_assert(((StkBytes) % 8U) == 0U,                                                \
+                   #Name ": stack size must be a multiple of 8 bytes");                    \
+    void Handler(void);                                                                    \
+    OSThread Name##_Thread;                                                                \
+    MCU_THREAD_STACK uint32_t Name##_Stack[(StkBytes) / sizeof(uint32_t)];                 \
+    static const OSThreadDef Name##_Def                                                    \
+      __attribute__((section("os_thread_def"), used, aligned(__alignof__(OSThreadDef)))) = \
+      { &Name##_Thread, &Handler, Name##_Stack, (uint32_t)(StkBytes), (uint8_t)(Prio) }
+
+  /* Initializes the operating system and starts the threads of OS_THREAD_DEFINE */
   void OS_Init(void *StackStorage, uint32_t SatckSize);
 
   /* Execute Idle thread */
   void OS_OnIdle(void);
 
-  /* This function must be called with interrupts DISABLED */
+  /* This function must be called in a critical section */
   void OS_Sched(void);
 
   /* Transfer control to the RTOS to run the threads */
@@ -28,6 +258,35 @@
   /* Blocking delay */
   void OS_msDelay(uint32_t Ticks);
 
+  /* Blocks until the tick count reaches Tick (OS_TIMEOUT if already passed) */
+  OSStatus OS_DelayUntil(uint32_t Tick);
+
+  /* Returns the number of ticks since OS_Run */
+  uint32_t OS_GetTickCount(void);
+
+  /* Returns the DWT cycles from reset to the first thread dispatch */
+  uint32_t OS_GetBootCycles(void);
+
+  #if (OS_CFG_HR_TIME == 1)
+  /* Returns the microsecond time stamp (wraps around after 2^32 us) */
+  uint32_t OS_GetMicroseconds(void);
+
+  /* Blocking delay in microseconds */
+  void OS_usDelay(uint32_t Us);
+
+  /* Blocks until the microsecond time reaches Us (OS_TIMEOUT if already passed) */
+  OSStatus OS_usDelayUntil(uint32_t Us);
+
+  /* Wakes the threads whose microsecond delay expired, called by the alarm interrupt */
+  void OS_HrAlarm(void);
+  #endif
+
+  /* Starts a periodic activation: the first one is Period ticks from now */
+  void OSPeriodic_Init(OSPeriodic *Periodic, uint32_t Period);
+
+  /* Blocks until the next activation, returns the number of activations missed */
+  uint32_t OSPeriodic_Wait(OSPeriodic *Periodic);
+
   /* Process all timeouts */
   void OS_Tick(void);
 
@@ -37,5 +296,53 @@
  /* Initializes a thread control block (TCB) and sets up its stack frame for execution by the OS. */
   void OSThread_Start(OSThread *TCB, uint8_t Prio, OSThreadHandler ThreadHandler, void *StkStorage, uint32_t StkSize);
 
+  /* Removes a thread from the OS so that its TCB and stack can be reused. */
+  void OSThread_Stop(OSThread *TCB);
+
+  /* Sets the round-robin time slice of a thread among threads of equal priority. */
+  void OSThread_SetTimeSlice(OSThread *TCB, uint32_t Ticks);
+
+  /* Returns the peak stack usage of a thread in bytes. */
+  uint32_t OSThread_StackHighWater(const OSThread *TCB);
+
+  /* Callback on a stack overflow detected at a context switch (must not return) */
+  void OS_OnStackOverflow(OSThread *Thread);
+
+  #if (OS_CFG_THREAD_STATS == 1)
+  /* Returns the run cycles and switch count of a thread. */
+  void OSThread_GetStats(const OSThread *TCB, OSThreadStats *Stats);
+
+  /* Returns the DWT cycles accounted to all threads since the first switch. */
+  uint64_t OS_GetTotalCycles(void);
+
+  /* Returns the share of the idle thread in the total cycles (0 .. 100). */
+  uint32_t OS_GetIdlePercent(void);
+
+  /* Accounts the cycles of the outgoing thread, called by PendSV_Handler before OS_Curr changes */
+  void OS_StatsSwitch(void);
+  #endif
+
+  /*----------------------------------------------------------------------------
+  - Kernel services for OS objects (must be called in a critical section)
+  -----------------------------------------------------------------------------*/
+  extern OSThread * volatile OS_Curr;
+  extern OSThread * volatile OS_Next;        /* thread PendSV switches to */
+  extern volatile uint32_t   OS_TickCount;   /* ticks since OS_Run (OS_GetTickCount) */
+
+  /* Blocks the current thread on the wait set of an object */
+  void OS_PendCurr(OSPrioSet *WaitSet, uint32_t Ticks);
+
+  /* Returns the pending thread following Thread (null: the highest) in a wait set */
+  OSThread *OS_NextWaiter(const OSPrioSet *WaitSet, const OSThread *Thread);
+
+  /* Wakes a pending thread */
+  void OS_WakeThread(OSThread *Thread);
+
+  /* Wakes the highest-priority thread of a non-empty wait set */
+  OSThread *OS_WakeHighest(OSPrioSet *WaitSet);
+
+  /* Changes the effective priority of a thread (priority inheritance) */
+  void OS_SetPrio(OSThread *Thread, uint8_t Prio);
+
 
 #endif /* OS_2025_08_02_H */
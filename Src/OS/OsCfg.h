@@ -0,0 +1,114 @@
+#ifndef OS_CFG_2026_10_17_H
+  #define OS_CFG_2026_10_17_H
+
+  /*----------------------------------------------------------------------------
+  - OS Configuration
+  -
+  - Every option can be overridden from the command line (e.g. -DOS_CFG_...=1).
+  -----------------------------------------------------------------------------*/
+
+  /* Tickless idle: 1 = suppress the periodic SysTick while all threads sleep,
+                    0 = fixed 1 ms tick */
+  #if !defined(OS_CFG_TICKLESS_IDLE)
+    #define OS_CFG_TICKLESS_IDLE          0
+  #endif
+
+  /* Highest thread priority (1 .. 255). Up to 32 the ready set and the
+     wait sets are single words, above they become two-level bitmaps */
+  #if !defined(OS_CFG_MAX_PRIO)
+    #define OS_CFG_MAX_PRIO               32U
+  #endif
+
+  /* Kernel interrupt ceiling: NVIC priority (1 .. 14, lower = more urgent)
+     of the most urgent interrupt that uses the kernel. The SysTick runs at
+     this priority and the context switch masks up to it with BASEPRI, more
+     urgent interrupts are never masked by PendSV_Handler. Plain number, it
+     is also used in assembly */
+  #if !defined(OS_CFG_KERNEL_IRQ_PRIO)
+    #define OS_CFG_KERNEL_IRQ_PRIO        5
+  #endif
+
+  /* Round-robin time slice in ticks for threads of equal priority
+     (0 = a thread runs until it blocks) */
+  #if !defined(OS_CFG_TIME_SLICE)
+    #define OS_CFG_TIME_SLICE             10U
+  #endif
+
+  /* Software timers: 1 = one-shot and periodic OSTimer timers, their
+                          callbacks run in a timer thread started by
+                          OS_Init,
+                      0 = no timers */
+  #if !defined(OS_CFG_TIMERS)
+    #define OS_CFG_TIMERS                 0
+  #endif
+
+  /* Priority of the timer thread (the timer callbacks run at it) */
+  #if !defined(OS_CFG_TIMER_PRIO)
+    #define OS_CFG_TIMER_PRIO             OS_CFG_MAX_PRIO
+  #endif
+
+  /* Stack size of the timer thread in bytes */
+  #if !defined(OS_CFG_TIMER_STACK_SIZE)
+    #define OS_CFG_TIMER_STACK_SIZE       512U
+  #endif
+
+  /* High-resolution time: 1 = microsecond time stamps and delays
+                              (OS_GetMicroseconds, OS_usDelay,
+                              OS_usDelayUntil) on a free-running 32-bit
+                              timer of the target, whose compare interrupt
+                              wakes the delayed threads (the tick rate is
+                              unchanged),
+                          0 = tick resolution only */
+  #if !defined(OS_CFG_HR_TIME)
+    #define OS_CFG_HR_TIME                0
+  #endif
+
+  /* Smallest stack in bytes accepted by OS_THREAD_DEFINE (checked at
+     build time): the initial context plus the frames of the thread */
+  #if !defined(OS_CFG_THREAD_STACK_MIN)
+    #define OS_CFG_THREAD_STACK_MIN       128U
+  #endif
+
+  /* Stack pre-fill: 1 = OSThread_Start fills the whole stack with a
+                         pattern, OSThread_StackHighWater scans it (one
+                         store per stack word at each start),
+                     0 = only the lowest stack word is written (the guard
+                         checked by OS_CFG_STACK_CHECK), the high-water
+                         mark reports the whole stack; for release builds
+                         that want the shorter thread start */
+  #if !defined(OS_CFG_STACK_FILL)
+    #define OS_CFG_STACK_FILL             1
+  #endif
+
+  /* Stack check: 1 = PendSV_Handler checks the stack pointer and the lowest
+                    stack word of the thread switched out and calls
+                    OS_OnStackOverflow() on overflow,
+                0 = no check */
+  #if !defined(OS_CFG_STACK_CHECK)
+    #define OS_CFG_STACK_CHECK            0
+  #endif
+
+  /* Thread statistics: 1 = PendSV_Handler and OS_Tick account the DWT cycles
+                           each thread runs and count its switches
+                           (OSThread_GetStats, OS_GetIdlePercent; the
+                           application must call Dwt_Init()),
+                       0 = no statistics */
+  #if !defined(OS_CFG_THREAD_STATS)
+    #define OS_CFG_THREAD_STATS           0
+  #endif
+
+  /* Scheduler trace: 1 = record switches, ready, delay, pend, tick and
+                          interrupt events in the OS_Trace ring buffer
+                          (one word each, see OsTrace.h; the application
+                          must call Dwt_Init()),
+                      0 = no trace */
+  #if !defined(OS_CFG_TRACE)
+    #define OS_CFG_TRACE                  0
+  #endif
+
+  /* Number of events kept by the trace (power of two) */
+  #if !defined(OS_CFG_TRACE_SIZE)
+    #define OS_CFG_TRACE_SIZE             256U
+  #endif
+
+#endif /* OS_CFG_2026_10_17_H */
@@ -0,0 +1,187 @@
+#include <stdint.h>
+#include "Mcal/Mcu.h"
+#include "OsEventFlags.h"
+
+
+/*----------------------------------------------------------------------------
+- OS Function Declarations
+-----------------------------------------------------------------------------*/
+static uint32_t OSEventFlags_Match(uint32_t Flags, uint32_t Mask, uint8_t Options);
+
+
+/*----------------------------------------------------------------------------
+- @brief OSEventFlags_Match
+
+- @desc Checks a wait condition against the current flags.
+
+- @param Flags     Current flags of the group
+         Mask      Flags waited for
+         Options   OS_FLAGS_ANY or OS_FLAGS_ALL
+
+- @return uint32_t  Matching flags if the condition is met, 0 otherwise
+-----------------------------------------------------------------------------*/
+static uint32_t OSEventFlags_Match(uint32_t Flags, uint32_t Mask, uint8_t Options)
+{
+  const uint32_t Matching = Flags & Mask;
+
+  if ((Options & OS_FLAGS_ALL) != 0U)
+  {
+    return ((Matching == Mask) ? Matching : 0U);
+  }
+
+  return Matching;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSEventFlags_Init
+
+- @desc Initializes an event flag group with all flags cleared.
+
+- @param Group   Event flag group to initialize
+
+- @return void
+-----------------------------------------------------------------------------*/
+void OSEventFlags_Init(OSEventFlags *Group)
+{
+  Group->Flags   = 0U;
+  OS_PrioSetInit(&Group->WaitSet);
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSEventFlags_Wait
+
+- @desc Waits until any/all of the flags in Mask are set. The wait
+        condition is kept in the caller's TCB while it is blocked in the
+        group wait set.
+
+- @param Group     Event flag group
+         Mask      Flags to wait for (not 0)
+         Options   OS_FLAGS_ANY or OS_FLAGS_ALL, optionally | OS_FLAGS_CONSUME
+         Flags     Receives the matching flags (may be null)
+         Ticks     Timeout in system ticks, OS_NO_WAIT or OS_WAIT_FOREVER
+
+- @return OSStatus  OS_OK if the condition was met, OS_TIMEOUT otherwise
+-----------------------------------------------------------------------------*/
+OSStatus OSEventFlags_Wait(OSEventFlags *Group, uint32_t Mask, uint8_t Options, uint32_t *Flags, uint32_t Ticks)
+{
+  OSStatus Status   = OS_OK;
+  uint32_t Matching;
+  OSCritical Crit;
+
+  OS_CRITICAL_ENTER(Crit);
+
+  Matching = OSEventFlags_Match(Group->Flags, Mask, Options);
+
+  if (Matching != 0U)
+  {
+    if ((Options & OS_FLAGS_CONSUME) != 0U)
+    {
+      Group->Flags &= ~Matching;
+    }
+
+    OS_CRITICAL_EXIT(Crit);
+  }
+  else if (Ticks == OS_NO_WAIT)
+  {
+    Status = OS_TIMEOUT;
+
+    OS_CRITICAL_EXIT(Crit);
+  }
+  else
+  {
+    OS_Curr->PendValue = Mask;
+    OS_Curr->PendOpt   = Options;
+
+    OS_PendCurr(&Group->WaitSet, Ticks);
+
+    OS_Sched();
+
+    /* The switch happens here; the setter stores the matching flags */
+    OS_CRITICAL_EXIT(Crit);
+
+    Status   = OS_Curr->PendStatus;
+    Matching = (Status == OS_OK) ? OS_Curr->PendValue : 0U;
+  }
+
+  if (Flags != (uint32_t *)0)
+  {
+    *Flags = Matching;
+  }
+
+  return Status;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSEventFlags_Set
+
+- @desc Sets flags and wakes every waiter whose condition is now met,
+        highest priority first (a consuming waiter may take the flags
+        before lower-priority waiters see them). May be called from an
+        ISR: the switch then happens in PendSV when the ISR returns.
+
+- @param Group   Event flag group
+         Mask    Flags to set
+
+- @return void
+-----------------------------------------------------------------------------*/
+void OSEventFlags_Set(OSEventFlags *Group, uint32_t Mask)
+{
+  OSCritical Crit;
+
+  OS_CRITICAL_ENTER(Crit);
+
+  Group->Flags |= Mask;
+
+  if (!OS_PrioSetIsEmpty(&Group->WaitSet))
+  {
+    OSThread *Thread = OS_NextWaiter(&Group->WaitSet, (OSThread *)0);
+
+    while (Thread != (OSThread *)0)
+    {
+      const uint32_t Matching = OSEventFlags_Match(Group->Flags, Thread->PendValue, Thread->PendOpt);
+
+      if (Matching != 0U)
+      {
+        if ((Thread->PendOpt & OS_FLAGS_CONSUME) != 0U)
+        {
+          Group->Flags &= ~Matching;
+        }
+
+        OS_WakeThread(Thread);
+
+        Thread->PendValue = Matching;
+      }
+
+      Thread = OS_NextWaiter(&Group->WaitSet, Thread);
+    }
+
+    OS_Sched();
+  }
+
+  OS_CRITICAL_EXIT(Crit);
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSEventFlags_Clear
+
+- @desc Clears flags of the group.
+
+- @param Group   Event flag group
+         Mask    Flags to clear
+
+- @return void
+-----------------------------------------------------------------------------*/
+void OSEventFlags_Clear(OSEventFlags *Group, uint32_t Mask)
+{
+  OSCritical Crit;
+
+  OS_CRITICAL_ENTER(Crit);
+
+  Group->Flags &= ~Mask;
+
+  OS_CRITICAL_EXIT(Crit);
+}
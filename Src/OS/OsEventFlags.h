@@ -0,0 +1,32 @@
+#ifndef OS_EVENT_FLAGS_2026_10_17_H
+  #define OS_EVENT_FLAGS_2026_10_17_H
+
+  #include <stdint.h>
+
+  #include "Os.h"
+
+  /* Wait options */
+  #define OS_FLAGS_ANY        (0x00U)   /* Wait for any of the flags */
+  #define OS_FLAGS_ALL        (0x01U)   /* Wait for all of the flags */
+  #define OS_FLAGS_CONSUME    (0x02U)   /* Clear the matching flags on return */
+
+  /* Group of 32 event flags */
+  typedef struct
+  {
+    uint32_t Flags;     /* Current flags */
+    OSPrioSet WaitSet;  /* Priorities waiting for flags */
+  } OSEventFlags;
+
+  /* Initializes an event flag group with all flags cleared */
+  void OSEventFlags_Init(OSEventFlags *Group);
+
+  /* Waits for flags of the group, blocking for at most Ticks */
+  OSStatus OSEventFlags_Wait(OSEventFlags *Group, uint32_t Mask, uint8_t Options, uint32_t *Flags, uint32_t Ticks);
+
+  /* Sets flags and wakes the threads whose condition is met (thread or ISR) */
+  void OSEventFlags_Set(OSEventFlags *Group, uint32_t Mask);
+
+  /* Clears flags */
+  void OSEventFlags_Clear(OSEventFlags *Group, uint32_t Mask);
+
+#endif /* OS_EVENT_FLAGS_2026_10_17_H */
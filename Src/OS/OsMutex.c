@@ -0,0 +1,257 @@
+#include <stdint.h>
+#include "Mcal/Mcu.h"
+#include "OsMutex.h"
+
+
+/*----------------------------------------------------------------------------
+- OS Function Declarations
+-----------------------------------------------------------------------------*/
+static void OSMutex_Acquire   (OSMutex *Mutex, OSThread *Owner);
+static void OSMutex_Release   (OSMutex *Mutex);
+static void OSMutex_UpdatePrio(OSThread *Owner);
+
+
+/*----------------------------------------------------------------------------
+- @brief OSMutex_Acquire / OSMutex_Release
+
+- @desc Makes a thread the owner of a mutex and adds the mutex to the
+        mutexes it holds / removes the mutex from the mutexes held by its
+        owner and leaves it without owner.
+        Must be called in a critical section.
+
+- @param Mutex   Mutex
+         Owner   New owner
+
+- @return void
+-----------------------------------------------------------------------------*/
+static void OSMutex_Acquire(OSMutex *Mutex, OSThread *Owner)
+{
+  Mutex->Owner     = Owner;
+  Mutex->Next      = Owner->MutexList;
+  Owner->MutexList = Mutex;
+}
+
+static void OSMutex_Release(OSMutex *Mutex)
+{
+  OSMutex **Link = &Mutex->Owner->MutexList;
+
+  while (*Link != Mutex)
+  {
+    Link = &(*Link)->Next;
+  }
+
+  *Link        = Mutex->Next;
+  Mutex->Next  = (OSMutex *)0;
+  Mutex->Owner = (OSThread *)0;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSMutex_UpdatePrio
+
+- @desc Recomputes the effective priority of a thread from its base
+        priority and the highest waiter of each mutex it still holds, so
+        an inherited priority lasts exactly as long as a waiter needs it
+        (nested locks, unlock, waiter timed out). If the thread itself
+        waits for a mutex, the change is passed on to the owner of that
+        mutex, and so on along the chain of blocked owners.
+        Must be called in a critical section.
+
+- @param Owner   Thread holding mutexes
+
+- @return void
+-----------------------------------------------------------------------------*/
+static void OSMutex_UpdatePrio(OSThread *Owner)
+{
+  while (Owner != (OSThread *)0)
+  {
+    uint32_t       Prio = Owner->BasePrio;
+    const OSMutex *Held;
+    const OSMutex *Blocked;
+
+    for (Held = Owner->MutexList; Held != (OSMutex *)0; Held = Held->Next)
+    {
+      if (!OS_PrioSetIsEmpty(&Held->WaitSet))
+      {
+        const uint32_t Waiter = OS_PrioSetHighest(&Held->WaitSet);
+
+        Prio = (Waiter > Prio) ? Waiter : Prio;
+      }
+    }
+
+    if (Prio == Owner->Prio)
+    {
+      break;
+    }
+
+    OS_SetPrio(Owner, (uint8_t)Prio);
+
+    /* A blocked owner moved in the wait set of its mutex: update that owner */
+    Blocked = Owner->PendMutex;
+
+    Owner = ((Blocked != (OSMutex *)0) && (Owner->PendSet == &Blocked->WaitSet)) ? Blocked->Owner : (OSThread *)0;
+  }
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSMutex_Init
+
+- @desc Initializes a mutex in the unlocked state without waiters.
+
+- @param Mutex   Mutex to initialize
+
+- @return void
+-----------------------------------------------------------------------------*/
+void OSMutex_Init(OSMutex *Mutex)
+{
+  Mutex->Owner   = (OSThread *)0;
+  Mutex->Next    = (OSMutex *)0;
+  OS_PrioSetInit(&Mutex->WaitSet);
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSMutex_Lock
+
+- @desc Locks the mutex, blocking the calling thread until it is available.
+        The mutex is not recursive: if the caller already owns it, the
+        call fails without blocking (see OSMutex_TimedLock).
+
+- @param Mutex   Mutex to lock
+
+- @return OSStatus  OS_OK if locked, OS_ERR_DEADLOCK if the caller already
+                    owns it
+-----------------------------------------------------------------------------*/
+OSStatus OSMutex_Lock(OSMutex *Mutex)
+{
+  return OSMutex_TimedLock(Mutex, OS_WAIT_FOREVER);
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSMutex_TimedLock
+
+- @desc Locks the mutex. If it is owned by another thread, the caller is
+        removed from OS_ReadySet and waits in the mutex wait set. An owner
+        with a lower priority than the caller inherits the caller's
+        priority while the caller waits, so that medium-priority threads
+        cannot delay the caller indefinitely; if the owner waits for
+        another mutex, its owner inherits the priority as well. If the wait times out, the
+        owner's priority is recomputed without the caller. The mutex is not
+        recursive: a second lock by the owner would wait for itself
+        forever and fails instead.
+
+- @param Mutex   Mutex to lock
+         Ticks   Timeout in system ticks, OS_NO_WAIT or OS_WAIT_FOREVER
+
+- @return OSStatus  OS_OK if locked, OS_ERR_DEADLOCK if the caller already
+                    owns it, OS_TIMEOUT otherwise
+-----------------------------------------------------------------------------*/
+OSStatus OSMutex_TimedLock(OSMutex *Mutex, uint32_t Ticks)
+{
+  OSStatus Status = OS_OK;
+  OSCritical Crit;
+
+  OS_CRITICAL_ENTER(Crit);
+
+  if (Mutex->Owner == (OSThread *)0)
+  {
+    OSMutex_Acquire(Mutex, OS_Curr);
+
+    OS_CRITICAL_EXIT(Crit);
+  }
+  else if (Mutex->Owner == OS_Curr)
+  {
+    Status = OS_ERR_DEADLOCK;
+
+    OS_CRITICAL_EXIT(Crit);
+  }
+  else if (Ticks == OS_NO_WAIT)
+  {
+    Status = OS_TIMEOUT;
+
+    OS_CRITICAL_EXIT(Crit);
+  }
+  else
+  {
+    OS_Curr->PendMutex = Mutex;
+
+    OS_PendCurr(&Mutex->WaitSet, Ticks);
+
+    /* Priority inheritance: run the owner (and the owners it waits for) at the caller's priority */
+    OSMutex_UpdatePrio(Mutex->Owner);
+
+    OS_Sched();
+
+    /* The switch happens here; ownership is handed over by the unlock */
+    OS_CRITICAL_EXIT(Crit);
+
+    Status = OS_Curr->PendStatus;
+
+    if (Status == OS_TIMEOUT)
+    {
+      /* The tick took the caller out of the wait set: drop the priority
+         the owner inherited from it (unless the mutex was freed since) */
+      OS_CRITICAL_ENTER(Crit);
+
+      if (Mutex->Owner != (OSThread *)0)
+      {
+        OSMutex_UpdatePrio(Mutex->Owner);
+        OS_Sched();
+      }
+
+      OS_CRITICAL_EXIT(Crit);
+    }
+  }
+
+  return Status;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSMutex_Unlock
+
+- @desc Unlocks the mutex and hands it over to the highest-priority
+        waiter, selected with LOG2 from the wait set; the new owner
+        inherits the priority of the remaining waiters. The caller keeps
+        the priority inherited through the other mutexes it still holds
+        and drops the rest.
+
+- @param Mutex   Mutex to unlock
+
+- @return OSStatus  OS_OK, or OS_ERR_NOT_OWNER if the caller does not own it
+-----------------------------------------------------------------------------*/
+OSStatus OSMutex_Unlock(OSMutex *Mutex)
+{
+  OSCritical Crit;
+
+  OS_CRITICAL_ENTER(Crit);
+
+  if (Mutex->Owner != OS_Curr)
+  {
+    OS_CRITICAL_EXIT(Crit);
+
+    return OS_ERR_NOT_OWNER;
+  }
+
+  OSMutex_Release(Mutex);
+
+  /* Keep only the priority inherited through the other mutexes held */
+  OSMutex_UpdatePrio(OS_Curr);
+
+  /* Hand the mutex over to the highest-priority waiter */
+  if (!OS_PrioSetIsEmpty(&Mutex->WaitSet))
+  {
+    OSThread *const Owner = OS_WakeHighest(&Mutex->WaitSet);
+
+    OSMutex_Acquire(Mutex, Owner);
+    OSMutex_UpdatePrio(Owner);
+  }
+
+  OS_Sched();
+
+  OS_CRITICAL_EXIT(Crit);
+
+  return OS_OK;
+}
@@ -0,0 +1,28 @@
+#ifndef OS_MUTEX_2026_10_17_H
+  #define OS_MUTEX_2026_10_17_H
+
+  #include <stdint.h>
+
+  #include "Os.h"
+
+  /* Mutex with priority inheritance, passed on along a chain of blocked owners */
+  typedef struct OSMutex_tag
+  {
+    OSThread *Owner;            /* Thread holding the mutex (null if free) */
+    OSPrioSet WaitSet;          /* Priorities waiting for the mutex */
+    struct OSMutex_tag *Next;   /* Next mutex held by the owner */
+  } OSMutex;
+
+  /* Initializes a mutex in the unlocked state */
+  void OSMutex_Init(OSMutex *Mutex);
+
+  /* Locks the mutex, blocking until it is available, OS_ERR_DEADLOCK if the caller owns it */
+  OSStatus OSMutex_Lock(OSMutex *Mutex);
+
+  /* Locks the mutex, blocking for at most Ticks (OS_NO_WAIT to try once), OS_ERR_DEADLOCK if the caller owns it */
+  OSStatus OSMutex_TimedLock(OSMutex *Mutex, uint32_t Ticks);
+
+  /* Unlocks the mutex and hands it over to the highest-priority waiter */
+  OSStatus OSMutex_Unlock(OSMutex *Mutex);
+
+#endif /* OS_MUTEX_2026_10_17_H */
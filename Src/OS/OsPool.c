@@ -0,0 +1,171 @@
+#include <stdint.h>
+#include "Mcal/Mcu.h"
+#include "OsPool.h"
+
+
+/*----------------------------------------------------------------------------
+- @brief OSPool_Init
+
+- @desc Initializes a pool by threading a free list through the blocks of
+        the storage. The block size is rounded up to a multiple of the
+        pointer size so that every block can hold the link. Allocation
+        and release are O(1) and cannot fragment.
+
+- @param Pool        Pool to initialize
+         Storage     Pointer-aligned storage (see OS_POOL_STORAGE)
+         BlockSize   Size of a block in bytes (at least 1)
+         NumBlocks   Number of blocks (at least 1)
+
+- @return OSStatus  OS_OK, or OS_ERR_PARAM if BlockSize or NumBlocks is 0
+                    (the pool then has no blocks: every allocation fails)
+-----------------------------------------------------------------------------*/
+OSStatus OSPool_Init(OSPool *Pool, void *Storage, uint32_t BlockSize, uint32_t NumBlocks)
+{
+  uint8_t   *Block = (uint8_t *)Storage;
+  const bool Valid = (BlockSize != 0U) && (NumBlocks != 0U);
+  uint32_t   Index;
+
+  BlockSize = (uint32_t)OS_POOL_BLOCK_SIZE(BlockSize);
+  NumBlocks = Valid ? NumBlocks : 0U;
+
+  Pool->FreeList  = (void *)0;
+  Pool->BlockSize = BlockSize;
+  Pool->NumFree   = NumBlocks;
+  OS_PrioSetInit(&Pool->WaitSet);
+
+  /* Link the blocks front to back */
+  for (Index = NumBlocks; Index > 0U; --Index)
+  {
+    void **Link = (void **)(void *)(Block + ((Index - 1U) * BlockSize));
+
+    *Link          = Pool->FreeList;
+    Pool->FreeList = (void *)Link;
+  }
+
+  return Valid ? OS_OK : OS_ERR_PARAM;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSPool_Alloc
+
+- @desc Takes the first block of the free list. Does not block and may be
+        called from an ISR.
+
+- @param Pool    Pool to allocate from
+
+- @return void*  Block, or null if the pool is empty
+-----------------------------------------------------------------------------*/
+void *OSPool_Alloc(OSPool *Pool)
+{
+  void *Block;
+  OSCritical Crit;
+
+  OS_CRITICAL_ENTER(Crit);
+
+  Block = Pool->FreeList;
+
+  if (Block != (void *)0)
+  {
+    Pool->FreeList = *(void **)Block;
+
+    --Pool->NumFree;
+  }
+
+  OS_CRITICAL_EXIT(Crit);
+
+  return Block;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSPool_AllocWait
+
+- @desc Allocates a block. If the pool is empty the caller is removed from
+        OS_ReadySet and waits until a block is freed; the freed block is
+        handed over directly.
+
+- @param Pool    Pool to allocate from
+         Block   Receives the block (null on timeout)
+         Ticks   Timeout in system ticks, OS_NO_WAIT or OS_WAIT_FOREVER
+
+- @return OSStatus  OS_OK if a block was allocated, OS_TIMEOUT otherwise
+-----------------------------------------------------------------------------*/
+OSStatus OSPool_AllocWait(OSPool *Pool, void **Block, uint32_t Ticks)
+{
+  OSStatus Status = OS_OK;
+  OSCritical Crit;
+
+  OS_CRITICAL_ENTER(Crit);
+
+  *Block = Pool->FreeList;
+
+  if (*Block != (void *)0)
+  {
+    Pool->FreeList = *(void **)(*Block);
+
+    --Pool->NumFree;
+
+    OS_CRITICAL_EXIT(Crit);
+  }
+  else if (Ticks == OS_NO_WAIT)
+  {
+    Status = OS_TIMEOUT;
+
+    OS_CRITICAL_EXIT(Crit);
+  }
+  else
+  {
+    OS_Curr->PendData = (void *)0;
+
+    OS_PendCurr(&Pool->WaitSet, Ticks);
+
+    OS_Sched();
+
+    /* The switch happens here; the block is handed over by OSPool_Free */
+    OS_CRITICAL_EXIT(Crit);
+
+    Status = OS_Curr->PendStatus;
+    *Block = OS_Curr->PendData;
+  }
+
+  return Status;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSPool_Free
+
+- @desc Returns a block. If threads wait for a block, it is handed over to
+        the highest-priority waiter, otherwise it is pushed onto the free
+        list. May be called from an ISR.
+
+- @param Pool    Pool the block was allocated from
+         Block   Block to free
+
+- @return void
+-----------------------------------------------------------------------------*/
+void OSPool_Free(OSPool *Pool, void *Block)
+{
+  OSCritical Crit;
+
+  OS_CRITICAL_ENTER(Crit);
+
+  if (!OS_PrioSetIsEmpty(&Pool->WaitSet))
+  {
+    OSThread *Thread = OS_WakeHighest(&Pool->WaitSet);
+
+    Thread->PendData = Block;
+
+    OS_Sched();
+  }
+  else
+  {
+    *(void **)Block = Pool->FreeList;
+    Pool->FreeList  = Block;
+
+    ++Pool->NumFree;
+  }
+
+  OS_CRITICAL_EXIT(Crit);
+}
@@ -0,0 +1,37 @@
+#ifndef OS_POOL_2026_10_17_H
+  #define OS_POOL_2026_10_17_H
+
+  #include <stdint.h>
+
+  #include "Os.h"
+
+  /* Fixed-block memory pool */
+  typedef struct
+  {
+    void     *FreeList;   /* First free block (the link is stored in the block) */
+    uint32_t BlockSize;   /* Size of a block in bytes (multiple of the pointer size) */
+    uint32_t NumFree;     /* Number of free blocks */
+    OSPrioSet WaitSet;    /* Priorities waiting for a block */
+  } OSPool;
+
+  /* Block size in bytes rounded up to a multiple of the pointer size (room for the link) */
+  #define OS_POOL_BLOCK_SIZE(BlockSize) \
+    ((((BlockSize) + sizeof(void *)) - 1U) / sizeof(void *) * sizeof(void *))
+
+  /* Declares pointer-aligned storage for a pool of NumBlocks blocks of BlockSize bytes */
+  #define OS_POOL_STORAGE(Name, BlockSize, NumBlocks) \
+    void *Name[(OS_POOL_BLOCK_SIZE(BlockSize) / sizeof(void *)) * (NumBlocks)]
+
+  /* Initializes a pool on caller-provided (pointer-aligned) storage (OS_ERR_PARAM if a size is 0) */
+  OSStatus OSPool_Init(OSPool *Pool, void *Storage, uint32_t BlockSize, uint32_t NumBlocks);
+
+  /* Allocates a block without blocking (thread or ISR), null if none is free */
+  void *OSPool_Alloc(OSPool *Pool);
+
+  /* Allocates a block, blocking for at most Ticks */
+  OSStatus OSPool_AllocWait(OSPool *Pool, void **Block, uint32_t Ticks);
+
+  /* Returns a block to the pool (thread or ISR) */
+  void OSPool_Free(OSPool *Pool, void *Block);
+
+#endif /* OS_POOL_2026_10_17_H */
@@ -0,0 +1,169 @@
+#include <stdint.h>
+#include "Mcal/Mcu.h"
+#include "OsQueue.h"
+
+
+/*----------------------------------------------------------------------------
+- OS Function Declarations
+-----------------------------------------------------------------------------*/
+static OSStatus OSQueue_Put(OSQueue *Queue, void *Msg);
+
+
+/*----------------------------------------------------------------------------
+- @brief OSQueue_Put
+
+- @desc Stores a message pointer in the ring and advances the write index.
+        Must be called in a critical section: it serializes the senders
+        (threads and ISRs of any priority up to the kernel ceiling), so
+        two of them cannot claim the same slot. The free-running indices
+        select the slot with a mask: Size is a power of two, so the slot
+        order is kept when they wrap around at 2^32.
+
+- @param Queue   Queue to write
+         Msg     Message pointer
+
+- @return OSStatus  OS_OK, or OS_ERR_FULL if all slots are used
+-----------------------------------------------------------------------------*/
+static OSStatus OSQueue_Put(OSQueue *Queue, void *Msg)
+{
+  const uint32_t Tail = Queue->Tail;
+
+  if ((Tail - Queue->Head) >= Queue->Size)
+  {
+    return OS_ERR_FULL;
+  }
+
+  Queue->Ring[Tail & (Queue->Size - 1U)] = Msg;
+  Queue->Tail                            = Tail + 1U;
+
+  return OS_OK;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSQueue_Init
+
+- @desc Initializes an empty queue. Only pointers are queued; the buffers
+        they point to are owned by the sender until received (e.g. blocks
+        of an OSPool), so no data is copied inside critical sections.
+
+- @param Queue     Queue to initialize
+         Storage   Array of Size message pointers
+         Size      Number of slots (a power of two)
+
+- @return OSStatus  OS_OK, or OS_ERR_PARAM if Size is 0 or not a power of
+                    two (the queue then has no slots: every send fails
+                    with OS_ERR_FULL)
+-----------------------------------------------------------------------------*/
+OSStatus OSQueue_Init(OSQueue *Queue, void **Storage, uint32_t Size)
+{
+  const bool Valid = (Size != 0U) && ((Size & (Size - 1U)) == 0U);
+
+  Queue->Ring    = Storage;
+  Queue->Size    = Valid ? Size : 0U;
+  Queue->Head    = 0U;
+  Queue->Tail    = 0U;
+  OS_PrioSetInit(&Queue->WaitSet);
+
+  return Valid ? OS_OK : OS_ERR_PARAM;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSQueue_Send
+
+- @desc Sends a message pointer and wakes the highest-priority receiver.
+        Does not block and may be called from an ISR: the slot is claimed
+        in a short kernel critical section, so threads and ISRs that
+        preempt each other can send to the same queue without losing a
+        message.
+
+- @param Queue   Queue to send to
+         Msg     Message pointer
+
+- @return OSStatus  OS_OK, or OS_ERR_FULL if the queue is full
+-----------------------------------------------------------------------------*/
+OSStatus OSQueue_Send(OSQueue *Queue, void *Msg)
+{
+  OSStatus Status;
+  OSCritical Crit;
+
+  OS_CRITICAL_ENTER(Crit);
+
+  Status = OSQueue_Put(Queue, Msg);
+
+  if ((Status == OS_OK) && !OS_PrioSetIsEmpty(&Queue->WaitSet))
+  {
+    (void) OS_WakeHighest(&Queue->WaitSet);
+
+    OS_Sched();
+  }
+
+  OS_CRITICAL_EXIT(Crit);
+
+  return Status;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSQueue_Receive
+
+- @desc Receives the oldest message pointer. If the queue is empty the
+        caller is removed from OS_ReadySet and waits in the queue wait set.
+        If another receiver takes the message first, the caller waits
+        again (with the full timeout).
+
+- @param Queue   Queue to receive from
+         Msg     Receives the message pointer
+         Ticks   Timeout in system ticks, OS_NO_WAIT or OS_WAIT_FOREVER
+
+- @return OSStatus  OS_OK if a message was received, OS_TIMEOUT otherwise
+-----------------------------------------------------------------------------*/
+OSStatus OSQueue_Receive(OSQueue *Queue, void **Msg, uint32_t Ticks)
+{
+  OSStatus Status = OS_OK;
+  OSCritical Crit;
+
+  for(;;)
+  {
+    OS_CRITICAL_ENTER(Crit);
+
+    if (Queue->Tail != Queue->Head)
+    {
+      const uint32_t Head = Queue->Head;
+
+      *Msg = Queue->Ring[Head & (Queue->Size - 1U)];
+
+      Queue->Head = Head + 1U;
+
+      OS_CRITICAL_EXIT(Crit);
+
+      break;
+    }
+
+    if (Ticks == OS_NO_WAIT)
+    {
+      Status = OS_TIMEOUT;
+
+      OS_CRITICAL_EXIT(Crit);
+
+      break;
+    }
+
+    OS_PendCurr(&Queue->WaitSet, Ticks);
+
+    OS_Sched();
+
+    /* The switch happens here */
+    OS_CRITICAL_EXIT(Crit);
+
+    Status = OS_Curr->PendStatus;
+
+    if (Status != OS_OK)
+    {
+      break;
+    }
+  }
+
+  return Status;
+}
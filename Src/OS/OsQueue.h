@@ -0,0 +1,27 @@
+#ifndef OS_QUEUE_2026_10_17_H
+  #define OS_QUEUE_2026_10_17_H
+
+  #include <stdint.h>
+
+  #include "Os.h"
+
+  /* Zero-copy message queue: passes pointers to (pool-allocated) buffers */
+  typedef struct
+  {
+    void     **Ring;            /* Storage for the message pointers */
+    uint32_t   Size;            /* Number of slots in Ring (power of two) */
+    volatile uint32_t Head;     /* Free-running read index (receivers) */
+    volatile uint32_t Tail;     /* Free-running write index (senders, serialized) */
+    OSPrioSet  WaitSet;         /* Priorities waiting for a message */
+  } OSQueue;
+
+  /* Initializes an empty queue on a caller-provided pointer array (OS_ERR_PARAM unless Size is a power of two) */
+  OSStatus OSQueue_Init(OSQueue *Queue, void **Storage, uint32_t Size);
+
+  /* Sends a message pointer (non-blocking, thread or ISR) */
+  OSStatus OSQueue_Send(OSQueue *Queue, void *Msg);
+
+  /* Receives a message pointer, blocking for at most Ticks */
+  OSStatus OSQueue_Receive(OSQueue *Queue, void **Msg, uint32_t Ticks);
+
+#endif /* OS_QUEUE_2026_10_17_H */
@@ -0,0 +1,99 @@
+#include <stdint.h>
+#include "Mcal/Mcu.h"
+#include "OsSem.h"
+
+
+/*----------------------------------------------------------------------------
+- @brief OSSem_Init
+
+- @desc Initializes a counting semaphore without waiters.
+
+- @param Sem     Semaphore to initialize
+         Count   Initial number of tokens
+
+- @return void
+-----------------------------------------------------------------------------*/
+void OSSem_Init(OSSem *Sem, uint32_t Count)
+{
+  Sem->Count   = Count;
+  OS_PrioSetInit(&Sem->WaitSet);
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSSem_Pend
+
+- @desc Takes a token. Without tokens the caller is removed from
+        OS_ReadySet and waits in the semaphore wait set.
+
+- @param Sem     Semaphore to take
+         Ticks   Timeout in system ticks, OS_NO_WAIT or OS_WAIT_FOREVER
+
+- @return OSStatus  OS_OK if a token was taken, OS_TIMEOUT otherwise
+-----------------------------------------------------------------------------*/
+OSStatus OSSem_Pend(OSSem *Sem, uint32_t Ticks)
+{
+  OSStatus Status = OS_OK;
+  OSCritical Crit;
+
+  OS_CRITICAL_ENTER(Crit);
+
+  if (Sem->Count != 0U)
+  {
+    --Sem->Count;
+
+    OS_CRITICAL_EXIT(Crit);
+  }
+  else if (Ticks == OS_NO_WAIT)
+  {
+    Status = OS_TIMEOUT;
+
+    OS_CRITICAL_EXIT(Crit);
+  }
+  else
+  {
+    OS_PendCurr(&Sem->WaitSet, Ticks);
+
+    OS_Sched();
+
+    /* The switch happens here; the token is handed over by the post */
+    OS_CRITICAL_EXIT(Crit);
+
+    Status = OS_Curr->PendStatus;
+  }
+
+  return Status;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSSem_Post
+
+- @desc Gives a token. If threads are waiting, the token is handed over to
+        the highest-priority waiter (one bit operation) and the scheduler
+        is invoked, otherwise the count is incremented. May be called from
+        an ISR: the switch then happens in PendSV when the ISR returns.
+
+- @param Sem     Semaphore to give
+
+- @return void
+-----------------------------------------------------------------------------*/
+MCU_RAMFUNC void OSSem_Post(OSSem *Sem)
+{
+  OSCritical Crit;
+
+  OS_CRITICAL_ENTER(Crit);
+
+  if (!OS_PrioSetIsEmpty(&Sem->WaitSet))
+  {
+    (void) OS_WakeHighest(&Sem->WaitSet);
+
+    OS_Sched();
+  }
+  else
+  {
+    ++Sem->Count;
+  }
+
+  OS_CRITICAL_EXIT(Crit);
+}
@@ -0,0 +1,24 @@
+#ifndef OS_SEM_2026_10_17_H
+  #define OS_SEM_2026_10_17_H
+
+  #include <stdint.h>
+
+  #include "Os.h"
+
+  /* Counting semaphore */
+  typedef struct
+  {
+    uint32_t Count;     /* Available tokens */
+    OSPrioSet WaitSet;  /* Priorities waiting for a token */
+  } OSSem;
+
+  /* Initializes a semaphore with a number of tokens */
+  void OSSem_Init(OSSem *Sem, uint32_t Count);
+
+  /* Takes a token, blocking for at most Ticks (OS_NO_WAIT to try once) */
+  OSStatus OSSem_Pend(OSSem *Sem, uint32_t Ticks);
+
+  /* Gives a token (thread or ISR) */
+  void OSSem_Post(OSSem *Sem);
+
+#endif /* OS_SEM_2026_10_17_H */
@@ -0,0 +1,352 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include "Mcal/Mcu.h"
+#include "OsSem.h"
+#include "OsTimer.h"
+
+#if (OS_CFG_TIMERS == 1)
+
+_Static_assert((OS_CFG_TIMER_PRIO >= 1U) && (OS_CFG_TIMER_PRIO <= OS_CFG_MAX_PRIO), "OS_CFG_TIMER_PRIO must be 1 .. OS_CFG_MAX_PRIO");
+
+/*----------------------------------------------------------------------------
+- OS Timer Variables
+-----------------------------------------------------------------------------*/
+static OSTimer  *OS_TimerList;  /* delta list of active timers, nearest expiry first */
+static OSSem     OS_TimerWake;  /* posted when the head of the list expires */
+static OSThread  OS_TimerThread;
+MCU_THREAD_STACK static uint32_t OS_TimerStack[OS_CFG_TIMER_STACK_SIZE / sizeof(uint32_t)];
+
+
+/*----------------------------------------------------------------------------
+- OS Function Declarations
+-----------------------------------------------------------------------------*/
+static void OS_TimerMain  (void);
+static void OS_TimerInsert(OSTimer *Timer, uint32_t Ticks);
+static void OS_TimerRemove(OSTimer *Timer);
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_TimerInsert
+
+- @desc Inserts a timer into the delta list of active timers. Each Delta
+        holds the ticks remaining after its predecessor expires. Expired
+        timers (zero delta) at the head are skipped, so a timer inserted
+        with zero ticks is served after them.
+        Must be called in a critical section.
+
+- @param Timer   Timer to insert
+         Ticks   Ticks to the expiry
+
+- @return void
+-----------------------------------------------------------------------------*/
+static void OS_TimerInsert(OSTimer *Timer, uint32_t Ticks)
+{
+  OSTimer *Prev = (OSTimer *)0;
+  OSTimer *Next = OS_TimerList;
+
+  /* Skip the timers that expire before (or together with) this one */
+  while ((Next != (OSTimer *)0) && (Next->Delta <= Ticks))
+  {
+    Ticks -= Next->Delta;
+    Prev   = Next;
+    Next   = Next->Next;
+  }
+
+  Timer->Delta = Ticks;
+  Timer->Next  = Next;
+  Timer->Prev  = Prev;
+
+  /* The successor now expires relative to the inserted timer */
+  if (Next != (OSTimer *)0)
+  {
+    Next->Delta -= Ticks;
+    Next->Prev   = Timer;
+  }
+
+  if (Prev != (OSTimer *)0)
+  {
+    Prev->Next   = Timer;
+  }
+  else
+  {
+    OS_TimerList = Timer;
+  }
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_TimerRemove
+
+- @desc Removes a timer from the list of active timers. Its remaining delta
+        is handed over to the successor. Does nothing if the timer is not
+        active.
+        Must be called in a critical section.
+
+- @param Timer   Timer to remove
+
+- @return void
+-----------------------------------------------------------------------------*/
+static void OS_TimerRemove(OSTimer *Timer)
+{
+  if ((Timer->Prev == (OSTimer *)0) && (OS_TimerList != Timer))
+  {
+    return;
+  }
+
+  if (Timer->Next != (OSTimer *)0)
+  {
+    Timer->Next->Delta += Timer->Delta;
+    Timer->Next->Prev   = Timer->Prev;
+  }
+
+  if (Timer->Prev != (OSTimer *)0)
+  {
+    Timer->Prev->Next   = Timer->Next;
+  }
+  else
+  {
+    OS_TimerList = Timer->Next;
+  }
+
+  Timer->Next = (OSTimer *)0;
+  Timer->Prev = (OSTimer *)0;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_TimerMain
+
+- @desc Timer thread: waits for the tick to report an expiry, then runs
+        the callbacks of all expired timers outside the critical section.
+        A periodic timer is re-inserted before its callback runs, at its
+        next deadline counted from the previous one, so late service does
+        not make it drift; periods missed entirely are skipped.
+
+- @param void
+
+- @return void
+-----------------------------------------------------------------------------*/
+static void OS_TimerMain(void)
+{
+  OSCritical Crit;
+
+  while(1U)
+  {
+    (void) OSSem_Pend(&OS_TimerWake, OS_WAIT_FOREVER);
+
+    OS_CRITICAL_ENTER(Crit);
+
+    while ((OS_TimerList != (OSTimer *)0) && (OS_TimerList->Delta == 0U))
+    {
+      OSTimer *const        Timer    = OS_TimerList;
+      const OSTimerCallback Callback = Timer->Callback;
+      void *const           Arg      = Timer->Arg;
+
+      OS_TimerRemove(Timer);
+
+      if (Timer->Period != 0U)
+      {
+        int32_t Left;
+
+        /* Next deadline still ahead, skipping the periods already missed */
+        do
+        {
+          Timer->Deadline += Timer->Period;
+          Left             = (int32_t)(Timer->Deadline - OS_TickCount);
+        } while (Left <= 0);
+
+        OS_TimerInsert(Timer, (uint32_t)Left);
+      }
+
+      OS_CRITICAL_EXIT(Crit);
+
+      Callback(Arg);
+
+      OS_CRITICAL_ENTER(Crit);
+    }
+
+    OS_CRITICAL_EXIT(Crit);
+  }
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_TimerInit
+
+- @desc Called by OS_Init: starts the timer thread.
+
+- @param void
+
+- @return void
+-----------------------------------------------------------------------------*/
+void OS_TimerInit(void)
+{
+  OS_TimerList = (OSTimer *)0;
+
+  OSSem_Init(&OS_TimerWake, 0U);
+
+  OSThread_Start(&OS_TimerThread, OS_CFG_TIMER_PRIO, &OS_TimerMain, OS_TimerStack, sizeof(OS_TimerStack));
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_TimerTick
+
+- @desc Called by OS_Tick: decrements the first timer that has not expired
+        yet. When it reaches zero, the timer thread is woken up; the
+        timers expiring together with it follow with a zero delta.
+
+- @param void
+
+- @return void
+-----------------------------------------------------------------------------*/
+MCU_RAMFUNC void OS_TimerTick(void)
+{
+  OSTimer *Timer = OS_TimerList;
+
+  /* Skip the expired timers the timer thread has not served yet */
+  while ((Timer != (OSTimer *)0) && (Timer->Delta == 0U))
+  {
+    Timer = Timer->Next;
+  }
+
+  if ((Timer != (OSTimer *)0) && (--Timer->Delta == 0U))
+  {
+    OSSem_Post(&OS_TimerWake);
+  }
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_TimerNextTimeout
+
+- @desc Returns the ticks to the nearest expiry for tickless idle. The
+        idle thread only runs once the timer thread has served all
+        expired timers, so the head has a non-zero delta.
+        Must be called in a critical section.
+
+- @param void
+
+- @return uint32_t  Ticks to the nearest expiry (STK_MAX_IDLE_TICKS if no
+                    timer is active)
+-----------------------------------------------------------------------------*/
+uint32_t OS_TimerNextTimeout(void)
+{
+  return (OS_TimerList != (OSTimer *)0) ? OS_TimerList->Delta : STK_MAX_IDLE_TICKS;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_TimerTickSuppressed
+
+- @desc Accounts for ticks that elapsed while the SysTick was suppressed.
+        No timer can expire here since the sleep never exceeds the
+        nearest expiry.
+        Must be called in a critical section.
+
+- @param Ticks   Number of suppressed ticks
+
+- @return void
+-----------------------------------------------------------------------------*/
+void OS_TimerTickSuppressed(uint32_t Ticks)
+{
+  if (OS_TimerList != (OSTimer *)0)
+  {
+    OS_TimerList->Delta -= Ticks;
+  }
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSTimer_Init
+
+- @desc Initializes a stopped timer.
+
+- @param Timer     Timer to initialize
+         Callback  Function run by the timer thread on expiry
+         Arg       Argument of the callback
+
+- @return void
+-----------------------------------------------------------------------------*/
+void OSTimer_Init(OSTimer *Timer, OSTimerCallback Callback, void *Arg)
+{
+  Timer->Next     = (OSTimer *)0;
+  Timer->Prev     = (OSTimer *)0;
+  Timer->Delta    = 0U;
+  Timer->Deadline = 0U;
+  Timer->Period   = 0U;
+  Timer->Callback = Callback;
+  Timer->Arg      = Arg;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSTimer_Start
+
+- @desc Starts a timer, or restarts it if it is active. The callback runs
+        in the timer thread, so it may use every OS service but should
+        not block: the other timers wait meanwhile.
+
+- @param Timer   Timer to start
+         Ticks   Ticks to the first expiry (0 is taken as 1)
+         Period  Ticks between the following expiries (0: one-shot)
+
+- @return void
+-----------------------------------------------------------------------------*/
+void OSTimer_Start(OSTimer *Timer, uint32_t Ticks, uint32_t Period)
+{
+  OSCritical Crit;
+
+  Ticks = (Ticks != 0U) ? Ticks : 1U;
+
+  OS_CRITICAL_ENTER(Crit);
+
+  OS_TimerRemove(Timer);
+
+  Timer->Deadline = OS_TickCount + Ticks;
+  Timer->Period   = Period;
+
+  OS_TimerInsert(Timer, Ticks);
+
+  OS_CRITICAL_EXIT(Crit);
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSTimer_Stop
+
+- @desc Stops a timer. A callback the timer thread has already started
+        still runs to completion.
+
+- @param Timer   Timer to stop
+
+- @return void
+-----------------------------------------------------------------------------*/
+void OSTimer_Stop(OSTimer *Timer)
+{
+  OSCritical Crit;
+
+  OS_CRITICAL_ENTER(Crit);
+
+  OS_TimerRemove(Timer);
+
+  OS_CRITICAL_EXIT(Crit);
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSTimer_IsActive
+
+- @desc Tells whether a timer is running, i.e. linked into the list of
+        active timers.
+
+- @param Timer   Timer to check
+
+- @return bool   true if the timer is active
+-----------------------------------------------------------------------------*/
+bool OSTimer_IsActive(const OSTimer *Timer)
+{
+  return (Timer->Prev != (OSTimer *)0) || (OS_TimerList == Timer);
+}
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef OS_TIMER_2026_10_17_H
+  #define OS_TIMER_2026_10_17_H
+
+  #include <stdbool.h>
+  #include <stdint.h>
+
+  #include "Os.h"
+
+  /*----------------------------------------------------------------------------
+  - Software timers (OS_CFG_TIMERS)
+  -
+  - Active timers are kept in a delta list ordered by deadline, like the
+  - delayed threads: the tick only decrements the head, the walk is done
+  - when a timer is started. Expired timers stay at the head of the list
+  - until the timer thread (priority OS_CFG_TIMER_PRIO) has run their
+  - callbacks.
+  -----------------------------------------------------------------------------*/
+
+  /* Called by the timer thread when a timer expires */
+  typedef void (*OSTimerCallback)(void *Arg);
+
+  /* One-shot or periodic software timer */
+  typedef struct OSTimer_tag
+  {
+    struct OSTimer_tag *Next;         /* Next timer in the active list */
+    struct OSTimer_tag *Prev;         /* Previous timer in the active list */
+    uint32_t        Delta;            /* Ticks to expire after the previous timer */
+    uint32_t        Deadline;         /* Tick count of the next expiry */
+    uint32_t        Period;           /* Reload in ticks (0: one-shot) */
+    OSTimerCallback Callback;         /* Function run by the timer thread */
+    void           *Arg;              /* Argument of the callback */
+  } OSTimer;
+
+  /* Initializes a stopped timer */
+  void OSTimer_Init(OSTimer *Timer, OSTimerCallback Callback, void *Arg);
+
+  /* (Re)starts a timer: first expiry after Ticks, then every Period ticks (0: one-shot) */
+  void OSTimer_Start(OSTimer *Timer, uint32_t Ticks, uint32_t Period);
+
+  /* Stops a timer */
+  void OSTimer_Stop(OSTimer *Timer);
+
+  /* Tells whether a timer is running */
+  bool OSTimer_IsActive(const OSTimer *Timer);
+
+  /*----------------------------------------------------------------------------
+  - Kernel hooks (OS_Init, OS_Tick and tickless idle)
+  -----------------------------------------------------------------------------*/
+
+  /* Starts the timer thread */
+  void OS_TimerInit(void);
+
+  /* Advances the timers by one tick, wakes the timer thread on expiry */
+  void OS_TimerTick(void);
+
+  /* Returns the ticks to the nearest expiry (STK_MAX_IDLE_TICKS if none) */
+  uint32_t OS_TimerNextTimeout(void);
+
+  /* Advances the timers by ticks that elapsed without a SysTick interrupt */
+  void OS_TimerTickSuppressed(uint32_t Ticks);
+
+#endif /* OS_TIMER_2026_10_17_H */
@@ -0,0 +1,116 @@
+#include <stdint.h>
+#include "Mcal/Mcu.h"
+#include "OsTrace.h"
+
+#if (OS_CFG_TRACE == 1)
+
+/*----------------------------------------------------------------------------
+- Trace Buffer
+-----------------------------------------------------------------------------*/
+OSTrace OS_Trace = { OS_TRACE_MAGIC, OS_CFG_TRACE_SIZE, 0U, { 0U } };
+
+#if (OS_CFG_TICKLESS_IDLE == 1)
+static uint32_t OS_TraceSleepStart;  /* DWT_CYCCNT at the start of the idle sleep */
+#endif
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_TraceIsrEnter
+
+- @desc Records the entry of an interrupt handler. The kernel interrupts
+        are masked while the event word is written.
+
+- @param Irq   Interrupt number (negative for system exceptions)
+
+- @return void
+-----------------------------------------------------------------------------*/
+MCU_RAMFUNC void OS_TraceIsrEnter(int32_t Irq)
+{
+  OSCritical Crit;
+
+  OS_CRITICAL_ENTER(Crit);
+  OS_TraceRecord((uint32_t)OS_TRACE_ISR_ENTER, (uint32_t)Irq);
+  OS_CRITICAL_EXIT(Crit);
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_TraceIsrExit
+
+- @desc Records the exit of an interrupt handler. The kernel interrupts
+        are masked while the event word is written.
+
+- @param Irq   Interrupt number (negative for system exceptions)
+
+- @return void
+-----------------------------------------------------------------------------*/
+MCU_RAMFUNC void OS_TraceIsrExit(int32_t Irq)
+{
+  OSCritical Crit;
+
+  OS_CRITICAL_ENTER(Crit);
+  OS_TraceRecord((uint32_t)OS_TRACE_ISR_EXIT, (uint32_t)Irq);
+  OS_CRITICAL_EXIT(Crit);
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_TraceSwitch
+
+- @desc Records the switch to OS_Next. Called by PendSV_Handler with
+        the kernel interrupts masked, after the context of OS_Curr is saved.
+
+- @param void
+
+- @return void
+-----------------------------------------------------------------------------*/
+MCU_RAMFUNC void OS_TraceSwitch(void)
+{
+  OS_TraceRecord((uint32_t)OS_TRACE_SWITCH, OS_Next->TraceId);
+}
+
+
+
+#if (OS_CFG_TICKLESS_IDLE == 1)
+/*----------------------------------------------------------------------------
+- @brief OS_TraceSleep
+
+- @desc Records the start of a tickless idle sleep as a delay of the idle
+        thread. Called by OS_OnIdle with interrupts disabled, right before
+        the CPU waits for the one-shot SysTick.
+
+- @param void
+
+- @return void
+-----------------------------------------------------------------------------*/
+void OS_TraceSleep(void)
+{
+  OS_TraceSleepStart = DWT_CYCCNT;
+  OS_TraceRecord((uint32_t)OS_TRACE_DELAY, 0U);
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OS_TraceWake
+
+- @desc Records the end of a tickless idle sleep. The sleep can exceed the
+        2^21 cycles of a timestamp, so the tick event carries the number of
+        whole 2^21-cycle periods that elapsed since OS_TraceSleep (plus 1 to
+        tell it from OS_Tick). Called by OS_OnIdle with interrupts disabled,
+        so no other event lies between the two records.
+
+- @param void
+
+- @return void
+-----------------------------------------------------------------------------*/
+void OS_TraceWake(void)
+{
+  uint32_t Periods = (DWT_CYCCNT - OS_TraceSleepStart) >> OS_TRACE_STAMP_BITS;
+
+  Periods = (Periods > OS_TRACE_SLEEP_MAX) ? OS_TRACE_SLEEP_MAX : Periods;
+
+  OS_TraceRecord((uint32_t)OS_TRACE_TICK, 1U + Periods);
+}
+#endif
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef OS_TRACE_2026_10_17_H
+  #define OS_TRACE_2026_10_17_H
+
+  #include <stdint.h>
+
+  #include "Mcal/Mcu.h"
+  #include "Os.h"
+
+  /*----------------------------------------------------------------------------
+  - Scheduler trace (OS_CFG_TRACE)
+  -
+  - Every event is one 32-bit word written to a ring buffer:
+  -
+  -   bits 31..29  event (OSTraceEvent)
+  -   bits 28..21  thread trace id (idle = 0) or interrupt number
+  -   bits 20..0   low 21 bits of DWT_CYCCNT
+  -
+  - OS_Trace is read post mortem (e.g. a debugger memory dump of the whole
+  - structure) and converted to a timeline by
+  - Build/tools/trace/OsTraceDecode.py. The timestamps are unwrapped by the
+  - decoder, the tick event keeps the gap between events below 2^21 cycles.
+  - A tickless idle sleep (OS_CFG_TICKLESS_IDLE) has no ticks: it is enclosed
+  - by a delay event of the idle thread (id 0) and a tick event whose id is
+  - 1 + the number of whole 2^21-cycle periods the sleep lasted, which the
+  - decoder adds to the unwrapped gap.
+  -----------------------------------------------------------------------------*/
+
+  /* Marks the start of OS_Trace in a memory dump ("OSTR") */
+  #define OS_TRACE_MAGIC        (0x5254534FUL)
+
+  #define OS_TRACE_STAMP_BITS   (21U)
+  #define OS_TRACE_ID_SHIFT     (21U)
+  #define OS_TRACE_EVENT_SHIFT  (29U)
+
+  /* Largest number of 2^21-cycle periods a sleep record can hold */
+  #define OS_TRACE_SLEEP_MAX    (0xFEU)
+
+  typedef enum
+  {
+    OS_TRACE_SWITCH    = 0,  /* PendSV_Handler switches to the thread */
+    OS_TRACE_READY     = 1,  /* thread made ready */
+    OS_TRACE_DELAY     = 2,  /* thread starts a delay (OS_msDelay) */
+    OS_TRACE_TICK      = 3,  /* OS_Tick (id 0), end of an idle sleep (id: 1 + periods) */
+    OS_TRACE_ISR_ENTER = 4,  /* interrupt handler entered (id: interrupt number) */
+    OS_TRACE_ISR_EXIT  = 5,  /* interrupt handler left (id: interrupt number) */
+    OS_TRACE_SCHED     = 6,  /* OS_Sched requests a switch to the thread */
+    OS_TRACE_PEND      = 7   /* thread blocks on an OS object */
+  } OSTraceEvent;
+
+  /* Trace buffer, dumped as a whole */
+  typedef struct
+  {
+    uint32_t Magic;                     /* OS_TRACE_MAGIC */
+    uint32_t Size;                      /* Number of words in Buf */
+    uint32_t Index;                     /* Events recorded so far, the next goes to Buf[Index % Size] */
+    uint32_t Buf[OS_CFG_TRACE_SIZE];    /* Event words, oldest at Buf[Index % Size] once wrapped */
+  } OSTrace;
+
+  _Static_assert((OS_CFG_TRACE_SIZE & (OS_CFG_TRACE_SIZE - 1U)) == 0U, "OS_CFG_TRACE_SIZE must be a power of two");
+
+  extern OSTrace OS_Trace;
+
+
+  /*----------------------------------------------------------------------------
+  - @brief OS_TraceRecord
+  -
+  - @desc Writes one event word. Must be called in a critical section
+  -       (or from PendSV_Handler/SysTick_Handler).
+  -
+  - @param Event   OSTraceEvent
+  - @param Id      Thread trace id or interrupt number (low 8 bits)
+  - @return void
+  -----------------------------------------------------------------------------*/
+  OS_INLINE void OS_TraceRecord(uint32_t Event, uint32_t Id)
+  {
+    OS_Trace.Buf[OS_Trace.Index & (OS_CFG_TRACE_SIZE - 1U)] =   (Event << OS_TRACE_EVENT_SHIFT)
+                                                              | ((Id & 0xFFU) << OS_TRACE_ID_SHIFT)
+                                                              | (DWT_CYCCNT & ((1UL << OS_TRACE_STAMP_BITS) - 1U));
+    ++OS_Trace.Index;
+  }
+
+  #if (OS_CFG_TRACE == 1)
+    #define OS_TRACE(Event, Id)       OS_TraceRecord((uint32_t)(Event), (uint32_t)(Id))
+    #define OS_TRACE_ISR_IN(Irq)      OS_TraceIsrEnter((int32_t)(Irq))
+    #define OS_TRACE_ISR_OUT(Irq)     OS_TraceIsrExit((int32_t)(Irq))
+    #define OS_TRACE_SLEEP()          OS_TraceSleep()
+    #define OS_TRACE_WAKE()           OS_TraceWake()
+  #else
+    #define OS_TRACE(Event, Id)       ((void) 0)
+    #define OS_TRACE_ISR_IN(Irq)      ((void) 0)
+    #define OS_TRACE_ISR_OUT(Irq)     ((void) 0)
+    #define OS_TRACE_SLEEP()          ((void) 0)
+    #define OS_TRACE_WAKE()           ((void) 0)
+  #endif
+
+  /* Records the entry of an interrupt handler (call first in the handler) */
+  void OS_TraceIsrEnter(int32_t Irq);
+
+  /* Records the exit of an interrupt handler (call last in the handler) */
+  void OS_TraceIsrExit(int32_t Irq);
+
+  /* Records the switch to OS_Next, called by PendSV_Handler */
+  void OS_TraceSwitch(void);
+
+  /* Records the start of a tickless idle sleep, called by OS_OnIdle */
+  void OS_TraceSleep(void);
+
+  /* Records the end of a tickless idle sleep with its length, called by OS_OnIdle */
+  void OS_TraceWake(void);
+
+#endif /* OS_TRACE_2026_10_17_H */
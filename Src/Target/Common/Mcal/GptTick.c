@@ -0,0 +1,171 @@
+#include <Mcal/Gpio.h>
+#include <Mcal/Gpt.h>
+#include <Mcal/Mcu.h>
+#include <OS/Os.h>
+#include <OS/OsTrace.h>
+
+/*----------------------------------------------------------------------------
+- File-Local Variables
+-----------------------------------------------------------------------------*/
+static volatile uint32_t millisec_low;   /* millisecond counter, low word */
+static volatile uint32_t millisec_high;  /* millisecond counter, carries of the low word */
+
+#if (GPT_CFG_TICK_STATS == 1)
+static Gpt_TickStatsType Gpt_TickStats;
+#endif
+
+
+/*----------------------------------------------------------------------------
+- Function Declarations
+-----------------------------------------------------------------------------*/
+void SysTick_Handler(void);
+
+MCU_RAMFUNC static void Gpt_AdvanceCounter(const uint32_t Ticks);
+
+
+/*----------------------------------------------------------------------------
+- @brief Gpt_AdvanceCounter
+-
+- @desc Adds ticks to the 64-bit millisecond counter kept as two words.
+  Called by SysTick_Handler and with interrupts disabled, so a reader
+  never interrupts an update.
+-
+- @param Ticks   Number of elapsed ticks
+- @return void
+-----------------------------------------------------------------------------*/
+MCU_RAMFUNC static void Gpt_AdvanceCounter(const uint32_t Ticks)
+{
+  const uint32_t Low = millisec_low + Ticks;
+
+  if (Low < Ticks)
+  {
+    ++millisec_high;
+  }
+
+  millisec_low = Low;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief Gpt_GetTimeElapsed
+-
+- @desc Returns the elapsed time in milliseconds from the system counter,
+  without a critical section: the SysTick may update the counter between
+  the reads of its two words, but then the high word read again differs
+  and the read is repeated. Safe from threads and from interrupts up to
+  the kernel ceiling.
+-
+- @param DummyChannelIndex   Unused channel index parameter
+- @return Gpt_ValueType      Elapsed time in milliseconds
+-----------------------------------------------------------------------------*/
+Gpt_ValueType Gpt_GetTimeElapsed(const Gpt_ChannelType DummyChannelIndex)
+{
+  uint32_t High;
+  uint32_t Low;
+
+  (void) DummyChannelIndex;
+
+  do
+  {
+    High = millisec_high;
+    Low  = millisec_low;
+  } while (High != millisec_high);
+
+  return ((Gpt_ValueType)High << 32U) | (Gpt_ValueType)Low;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief Gpt_GetTimeElapsed32
+-
+- @desc Returns the low 32 bits of the millisecond counter: a single load,
+  wraps around after 2^32 ms (about 49 days). Compare such time stamps
+  by their signed difference.
+-
+- @param DummyChannelIndex   Unused channel index parameter
+- @return uint32_t           Elapsed time in milliseconds (modulo 2^32)
+-----------------------------------------------------------------------------*/
+uint32_t Gpt_GetTimeElapsed32(const Gpt_ChannelType DummyChannelIndex)
+{
+  (void) DummyChannelIndex;
+
+  return millisec_low;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief Gpt_AddElapsedTicks
+-
+- @desc Advances the millisecond counter by ticks that elapsed while the
+  periodic SysTick interrupt was suppressed (tickless idle).
+  Must be called with interrupts DISABLED.
+-
+- @param Ticks   Number of elapsed ticks
+- @return void
+-----------------------------------------------------------------------------*/
+void Gpt_AddElapsedTicks(const uint32_t Ticks)
+{
+  Gpt_AdvanceCounter(Ticks);
+}
+
+
+#if (GPT_CFG_TICK_STATS == 1)
+/*----------------------------------------------------------------------------
+- @brief Gpt_GetTickStats
+-
+- @desc Returns the number of SysTick interrupts taken and the CPU cycles
+  spent in them, used to compare tick against tickless runs.
+-
+- @param Stats   Destination of the statistics
+- @return void
+-----------------------------------------------------------------------------*/
+void Gpt_GetTickStats(Gpt_TickStatsType *Stats)
+{
+  OSCritical Crit;
+
+  OS_CRITICAL_ENTER(Crit);
+  *Stats = Gpt_TickStats;
+  OS_CRITICAL_EXIT(Crit);
+}
+#endif
+
+
+/*----------------------------------------------------------------------------
+- @brief SysTick_Handler
+-
+- @desc SysTick interrupt service routine: increments millisecond counter,
+  updates delayed threads, runs scheduler, toggles PC2 for timing (no-op
+  on the host and the emulated board) and, with GPT_CFG_TICK_STATS,
+  accumulates its own cycle count.
+-
+- @param void
+- @return void
+-----------------------------------------------------------------------------*/
+MCU_RAMFUNC void SysTick_Handler(void)
+{
+#if (GPT_CFG_TICK_STATS == 1)
+  const uint32_t IsrStart = DWT_CYCCNT;
+#endif
+  OSCritical Crit;
+
+  OS_TRACE_ISR_IN(SysTick_IRQn);
+
+  PC2_On();
+
+  Gpt_AdvanceCounter(1U);
+
+  OS_Tick();
+
+  OS_CRITICAL_ENTER(Crit);
+  OS_Sched();
+
+#if (GPT_CFG_TICK_STATS == 1)
+  ++Gpt_TickStats.IsrCount;
+  Gpt_TickStats.IsrCycles += (uint64_t)(DWT_CYCCNT - IsrStart);
+#endif
+  OS_CRITICAL_EXIT(Crit);
+
+  PC2_Off();
+
+  OS_TRACE_ISR_OUT(SysTick_IRQn);
+}
@@ -0,0 +1,75 @@
+#ifndef GPT_TICK_2026_10_17_H
+  #define GPT_TICK_2026_10_17_H
+
+  #include <stdbool.h>
+  #include <stdint.h>
+
+  /*----------------------------------------------------------------------------
+  - Target-independent part of the Gpt driver (GptTick.c): the millisecond
+  - counter advanced by SysTick_Handler and the deadlines built on it.
+  - Included by the Gpt.h of each target, which adds its hardware time base.
+  -----------------------------------------------------------------------------*/
+
+  /* Defines the type used to identify timer channels and timer counter */
+  typedef uint64_t Gpt_ValueType;
+  typedef uint8_t Gpt_ChannelType;
+
+  /* SysTick statistics: 1 = SysTick_Handler counts its interrupts and the
+                             DWT cycles spent in them (benchmarks),
+                         0 = no bookkeeping in the tick */
+  #if !defined(GPT_CFG_TICK_STATS)
+    #define GPT_CFG_TICK_STATS   0
+  #endif
+
+  /* SysTick interrupt statistics in DWT_CYCCNT units (CPU cycles, nanoseconds on the host) */
+  typedef struct
+  {
+    uint32_t IsrCount;   /* Number of SysTick interrupts taken */
+    uint64_t IsrCycles;  /* DWT_CYCCNT counts spent inside SysTick_Handler */
+  } Gpt_TickStatsType;
+
+  /* Returns the elapsed time in milliseconds from the system counter. */
+  Gpt_ValueType Gpt_GetTimeElapsed(const Gpt_ChannelType DummyChannelIndex);
+
+  /* Returns the low 32 bits of the elapsed time in milliseconds (single load, wraps around). */
+  uint32_t Gpt_GetTimeElapsed32(const Gpt_ChannelType DummyChannelIndex);
+
+  /* Advances the system counter by ticks that elapsed without a SysTick interrupt. */
+  void Gpt_AddElapsedTicks(const uint32_t Ticks);
+
+  #if (GPT_CFG_TICK_STATS == 1)
+  /* Returns the SysTick interrupt statistics. */
+  void Gpt_GetTickStats(Gpt_TickStatsType *Stats);
+  #endif
+
+  /*----------------------------------------------------------------------------
+  - @brief TimerStart
+  -
+  - @desc Creates a timer deadline by adding the given duration (ms)
+    to the low 32 bits of the current system time.
+  -
+  - @param millisec   Duration in milliseconds (at most 2^31 - 1)
+  - @return uint32_t  Absolute timeout value (modulo 2^32)
+  -----------------------------------------------------------------------------*/
+  static inline uint32_t TimerStart(const unsigned millisec)
+  {
+    return Gpt_GetTimeElapsed32(0U) + (uint32_t)millisec;
+  }
+
+
+  /*----------------------------------------------------------------------------
+  - @brief TimerTimeout
+  -
+  - @desc Checks whether the given timer deadline has expired. The signed
+    difference keeps the comparison right across the 32-bit wrap around.
+  -
+  - @param MyTimer   Absolute timeout value (from TimerStart)
+  - @return bool     true if expired, false otherwise
+  -----------------------------------------------------------------------------*/
+  static inline bool TimerTimeout(const uint32_t MyTimer)
+  {
+    return (((int32_t)(Gpt_GetTimeElapsed32(0U) - MyTimer) > 0) ? true : false);
+  }
+
+
+#endif /* GPT_TICK_2026_10_17_H */
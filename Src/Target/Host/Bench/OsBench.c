@@ -0,0 +1,756 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <Mcal/Gpio.h>
+#include <Mcal/Gpt.h>
+#include <Mcal/Mcu.h>
+#include <OS/Os.h>
+#include <OS/OsEventFlags.h>
+#include <OS/OsMutex.h>
+#include <OS/OsPool.h>
+#include <OS/OsQueue.h>
+#include <OS/OsSem.h>
+#include <OS/OsTimer.h>
+
+/*--------------------------------------------------------------
+- Benchmark Configuration
+---------------------------------------------------------------*/
+#define BENCH_STACK_WORDS       (16384U)    /* 64 KB: SysTick signal frames land on the thread stacks */
+#define BENCH_SWITCH_ROUNDS     (100000UL)  /* ping-pong round trips (2 switches each) */
+#define BENCH_LATENCY_ROUNDS    (20000UL)   /* post-to-wakeup samples */
+#define BENCH_DELAYED_THREADS   (32U)       /* threads in the delayed list during the tick benchmark */
+#define BENCH_RR_THREADS        (4U)        /* busy threads sharing one priority */
+#define BENCH_RUN_TICKS         (200UL)     /* duration of the tick and round-robin benchmarks */
+#define BENCH_ZERO_DELAY_TICKS  (5UL)       /* delay queued behind a zero delay */
+#define BENCH_QUEUE_SIZE        (4U)        /* slots of the checked queue */
+#define BENCH_POOL_BLOCK        (5U)        /* block size of the checked pool, rounded up to pointers */
+#define BENCH_POOL_BLOCKS       (3U)        /* blocks of the checked pool */
+#define BENCH_TIMER_EVENTS      (8U)        /* expiries logged by the timer check */
+
+#define BENCH_PRIO_CONTROL      (30U)
+#define BENCH_PRIO_HIGH         (20U)
+#define BENCH_PRIO_LOW          (10U)
+
+#define BENCH_NUM_THREADS       (BENCH_DELAYED_THREADS + 3U)
+
+/*--------------------------------------------------------------
+- Global Variables
+---------------------------------------------------------------*/
+uint32_t IdleThread_Stack[BENCH_STACK_WORDS];
+uint32_t Control_Stack   [BENCH_STACK_WORDS];
+uint32_t Bench_Stack     [BENCH_NUM_THREADS][BENCH_STACK_WORDS];
+
+OSThread Control_Thread;
+OSThread Bench_Thread[BENCH_NUM_THREADS];
+
+static OSSem             Bench_Ping;
+static OSSem             Bench_Pong;
+static volatile uint32_t Bench_PostTime;
+static uint64_t          Bench_LatencySum;
+static uint32_t          Bench_LatencyMax;
+static volatile uint32_t Bench_Loops[BENCH_RR_THREADS];
+
+static OSSem             Bench_Gate;
+static OSMutex           Bench_Mutex[3];
+static volatile OSStatus Bench_Status;
+static OSQueue           Bench_Queue;
+static void             *Bench_QueueRing[BENCH_QUEUE_SIZE];
+static uint32_t          Bench_Msg[BENCH_QUEUE_SIZE + 1U];
+static void * volatile   Bench_Received;
+static OSPool            Bench_Pool;
+static OS_POOL_STORAGE(Bench_PoolStorage, BENCH_POOL_BLOCK, BENCH_POOL_BLOCKS);
+static OSEventFlags      Bench_Flags;
+static volatile uint32_t Bench_FlagsSeen[2];
+
+#if (OS_CFG_TIMERS == 1)
+static OSTimer           Bench_Timer[5];
+static uint32_t          Bench_TimerStart;
+static uint32_t          Bench_TimerCount;
+static uint32_t          Bench_TimerLog[BENCH_TIMER_EVENTS];
+#endif
+
+
+/*--------------------------------------------------------------
+- Function Declarations
+---------------------------------------------------------------*/
+void Control_Main (void);
+void Pong_Main    (void);
+void Poster_Main  (void);
+void Waiter_Main  (void);
+void Delayed_Main (void);
+void Busy_Main    (void);
+void Yield_Main   (void);
+void Owner_Main   (void);
+void Middle_Main  (void);
+void Top_Main     (void);
+void Receiver_Main(void);
+void Alloc_Main   (void);
+void FlagsAll_Main(void);
+void FlagsAny_Main(void);
+
+static void Bench_Report     (const char *Name, uint64_t Value, const char *Unit);
+static void Bench_Check      (const char *Name, bool Ok);
+static void Bench_StopAll    (void);
+static void Bench_CheckMutex (void);
+static void Bench_CheckQueue (void);
+static void Bench_CheckPool  (void);
+static void Bench_CheckFlags (void);
+static void Bench_CheckUntil (void);
+
+#if (OS_CFG_TIMERS == 1)
+static void Bench_TimerLogExpiry (void *Arg);
+static void Bench_CheckTimers    (void);
+#endif
+
+
+/*--------------------------------------------------------------
+- @brief Bench_Report
+-
+- @desc Prints one result as "BENCH <name> <value> <unit>".
+---------------------------------------------------------------*/
+static void Bench_Report(const char *Name, uint64_t Value, const char *Unit)
+{
+  (void) printf("BENCH %-24s %10llu %s\n", Name, (unsigned long long)Value, Unit);
+  (void) fflush(stdout);
+}
+
+
+/*--------------------------------------------------------------
+- @brief Bench_Check
+-
+- @desc Fails the run with "BENCH_FAIL <name>" unless the
+-       condition holds.
+---------------------------------------------------------------*/
+static void Bench_Check(const char *Name, bool Ok)
+{
+  if (!Ok)
+  {
+    (void) printf("BENCH_FAIL %s\n", Name);
+    exit(EXIT_FAILURE);
+  }
+}
+
+
+/*--------------------------------------------------------------
+- @brief Bench_StopAll
+-
+- @desc Stops the benchmark threads of the previous phase.
+---------------------------------------------------------------*/
+static void Bench_StopAll(void)
+{
+  uint32_t Index;
+
+  for (Index = 0U; Index < BENCH_NUM_THREADS; ++Index)
+  {
+    OSThread_Stop(&Bench_Thread[Index]);
+  }
+}
+
+
+/*--------------------------------------------------------------
+- Benchmark Threads
+---------------------------------------------------------------*/
+
+/* Context switch: returns the token of Control_Main */
+void Pong_Main(void)
+{
+  while (1U)
+  {
+    (void) OSSem_Pend(&Bench_Ping, OS_WAIT_FOREVER);
+    OSSem_Post(&Bench_Pong);
+  }
+}
+
+/* Latency: a low-priority poster wakes a high-priority waiter */
+void Poster_Main(void)
+{
+  uint32_t Round;
+
+  for (Round = 0U; Round < BENCH_LATENCY_ROUNDS; ++Round)
+  {
+    Bench_PostTime = DWT_CYCCNT;
+    OSSem_Post(&Bench_Ping);
+  }
+
+  /* Done: wake Control_Main and exit */
+  OSSem_Post(&Bench_Pong);
+}
+
+void Waiter_Main(void)
+{
+  while (1U)
+  {
+    (void) OSSem_Pend(&Bench_Ping, OS_WAIT_FOREVER);
+
+    const uint32_t Latency = DWT_CYCCNT - Bench_PostTime;
+
+    Bench_LatencySum += Latency;
+
+    if (Latency > Bench_LatencyMax)
+    {
+      Bench_LatencyMax = Latency;
+    }
+  }
+}
+
+/* Tick load: periodic threads with different periods */
+void Delayed_Main(void)
+{
+  const uint32_t Period = (uint32_t)(OS_Curr - &Bench_Thread[0]) + 1U;
+
+  while (1U)
+  {
+    OS_msDelay(Period);
+  }
+}
+
+/* Round robin: busy threads of equal priority */
+void Busy_Main(void)
+{
+  const uint32_t Index = (uint32_t)(OS_Curr - &Bench_Thread[0]);
+
+  while (1U)
+  {
+    ++Bench_Loops[Index];
+  }
+}
+
+
+/* Zero delay: queued in front of a delayed thread every tick */
+void Yield_Main(void)
+{
+  while (1U)
+  {
+    OS_msDelay(0U);
+  }
+}
+
+/* Mutex checks: holds mutexes 0 and 1, releases one per gate post */
+void Owner_Main(void)
+{
+  (void) OSMutex_Lock(&Bench_Mutex[0]);
+  Bench_Status = OSMutex_Lock(&Bench_Mutex[0]);
+  (void) OSMutex_Lock(&Bench_Mutex[1]);
+
+  (void) OSSem_Pend(&Bench_Gate, OS_WAIT_FOREVER);
+  (void) OSMutex_Unlock(&Bench_Mutex[0]);
+
+  (void) OSSem_Pend(&Bench_Gate, OS_WAIT_FOREVER);
+  (void) OSMutex_Unlock(&Bench_Mutex[1]);
+}
+
+/* Mutex checks: holds mutex 2 and waits for mutex 0 */
+void Middle_Main(void)
+{
+  (void) OSMutex_Lock(&Bench_Mutex[2]);
+  (void) OSMutex_Lock(&Bench_Mutex[0]);
+  (void) OSMutex_Unlock(&Bench_Mutex[0]);
+  (void) OSMutex_Unlock(&Bench_Mutex[2]);
+}
+
+/* Mutex checks: waits for mutex 2 */
+void Top_Main(void)
+{
+  (void) OSMutex_Lock(&Bench_Mutex[2]);
+  (void) OSMutex_Unlock(&Bench_Mutex[2]);
+}
+
+
+/* Queue checks: blocks until a message arrives */
+void Receiver_Main(void)
+{
+  void *Msg;
+
+  Bench_Status   = OSQueue_Receive(&Bench_Queue, &Msg, OS_WAIT_FOREVER);
+  Bench_Received = Msg;
+}
+
+
+/* Pool checks: blocks until a block is freed */
+void Alloc_Main(void)
+{
+  void *Block;
+
+  Bench_Status   = OSPool_AllocWait(&Bench_Pool, &Block, OS_WAIT_FOREVER);
+  Bench_Received = Block;
+}
+
+
+/* Event flag checks: wait for all of 0x3 (consumed) / any of 0xC */
+void FlagsAll_Main(void)
+{
+  uint32_t Flags;
+
+  if (OSEventFlags_Wait(&Bench_Flags, 0x3U, OS_FLAGS_ALL | OS_FLAGS_CONSUME, &Flags, OS_WAIT_FOREVER) == OS_OK)
+  {
+    Bench_FlagsSeen[0] = Flags;
+  }
+}
+
+void FlagsAny_Main(void)
+{
+  uint32_t Flags;
+
+  if (OSEventFlags_Wait(&Bench_Flags, 0xCU, OS_FLAGS_ANY, &Flags, OS_WAIT_FOREVER) == OS_OK)
+  {
+    Bench_FlagsSeen[1] = Flags;
+  }
+}
+
+
+/*--------------------------------------------------------------
+- @brief Bench_CheckMutex
+-
+- @desc Priority inheritance along a chain of blocked owners,
+-       its recompute on waiter timeout and on unlock, and the
+-       failed second lock by the owner.
+---------------------------------------------------------------*/
+static void Bench_CheckMutex(void)
+{
+  OSThread *const Owner  = &Bench_Thread[0];
+  OSThread *const Middle = &Bench_Thread[1];
+  OSThread *const Top    = &Bench_Thread[2];
+  uint32_t Index;
+
+  OSSem_Init(&Bench_Gate, 0U);
+
+  for (Index = 0U; Index < 3U; ++Index)
+  {
+    OSMutex_Init(&Bench_Mutex[Index]);
+  }
+
+  OSThread_Start(Owner, BENCH_PRIO_LOW, &Owner_Main, Bench_Stack[0], sizeof(Bench_Stack[0]));
+  OS_msDelay(1U);
+
+  Bench_Check("mutex_self_lock", Bench_Status == OS_ERR_DEADLOCK);
+
+  /* Middle waits for the owner: the owner inherits its priority */
+  OSThread_Start(Middle, BENCH_PRIO_LOW + 2U, &Middle_Main, Bench_Stack[1], sizeof(Bench_Stack[1]));
+  OS_msDelay(1U);
+
+  Bench_Check("mutex_inherit", Owner->Prio == (BENCH_PRIO_LOW + 2U));
+
+  /* Top waits for Middle, which waits for the owner: both inherit */
+  OSThread_Start(Top, BENCH_PRIO_HIGH, &Top_Main, Bench_Stack[2], sizeof(Bench_Stack[2]));
+  OS_msDelay(1U);
+
+  Bench_Check("mutex_inherit_chain", (Middle->Prio == BENCH_PRIO_HIGH) && (Owner->Prio == BENCH_PRIO_HIGH));
+
+  /* A waiter that times out takes its priority back */
+  Bench_Check("mutex_timeout", OSMutex_TimedLock(&Bench_Mutex[1], 2U) == OS_TIMEOUT);
+  Bench_Check("mutex_timeout_prio", Owner->Prio == BENCH_PRIO_HIGH);
+
+  /* Unlock of mutex 0: the chain runs through, the owner keeps mutex 1 at its base priority */
+  OSSem_Post(&Bench_Gate);
+  OS_msDelay(1U);
+
+  Bench_Check("mutex_unlock_prio", (Owner->Prio == BENCH_PRIO_LOW) && (Middle->Prio == (BENCH_PRIO_LOW + 2U)) && (Top->Prio == BENCH_PRIO_HIGH));
+  Bench_Check("mutex_handover", (Bench_Mutex[0].Owner == (OSThread *)0) && (Bench_Mutex[2].Owner == (OSThread *)0) && (Bench_Mutex[1].Owner == Owner));
+
+  OSSem_Post(&Bench_Gate);
+  OS_msDelay(1U);
+
+  Bench_Check("mutex_unlock_last", (Bench_Mutex[1].Owner == (OSThread *)0) && (Owner->Prio == BENCH_PRIO_LOW));
+
+  Bench_StopAll();
+}
+
+
+/*--------------------------------------------------------------
+- @brief Bench_CheckQueue
+-
+- @desc Size validation, FIFO order across the 2^32 wrap of the
+-       free-running indices, the full and empty paths, the
+-       receive timeout and the wakeup of a blocked receiver.
+---------------------------------------------------------------*/
+static void Bench_CheckQueue(void)
+{
+  void    *Msg = (void *)0;
+  uint32_t Index;
+  uint32_t Start;
+  bool     Fifo = true;
+
+  Bench_Check("queue_size_zero", OSQueue_Init(&Bench_Queue, Bench_QueueRing, 0U) == OS_ERR_PARAM);
+  Bench_Check("queue_size_pow2", OSQueue_Init(&Bench_Queue, Bench_QueueRing, 3U) == OS_ERR_PARAM);
+  Bench_Check("queue_size_full", OSQueue_Send(&Bench_Queue, &Bench_Msg[0]) == OS_ERR_FULL);
+  Bench_Check("queue_init", OSQueue_Init(&Bench_Queue, Bench_QueueRing, BENCH_QUEUE_SIZE) == OS_OK);
+
+  /* Start the indices just below the wrap around */
+  Bench_Queue.Head = 0xFFFFFFFEUL;
+  Bench_Queue.Tail = 0xFFFFFFFEUL;
+
+  for (Index = 0U; Index < BENCH_QUEUE_SIZE; ++Index)
+  {
+    Fifo = Fifo && (OSQueue_Send(&Bench_Queue, &Bench_Msg[Index]) == OS_OK);
+  }
+
+  Bench_Check("queue_full", OSQueue_Send(&Bench_Queue, &Bench_Msg[BENCH_QUEUE_SIZE]) == OS_ERR_FULL);
+
+  for (Index = 0U; Index < BENCH_QUEUE_SIZE; ++Index)
+  {
+    Fifo = Fifo && (OSQueue_Receive(&Bench_Queue, &Msg, OS_NO_WAIT) == OS_OK) && (Msg == &Bench_Msg[Index]);
+  }
+
+  Bench_Check("queue_fifo_wrap", Fifo && (Bench_Queue.Head == 2U));
+  Bench_Check("queue_empty", OSQueue_Receive(&Bench_Queue, &Msg, OS_NO_WAIT) == OS_TIMEOUT);
+
+  Start = OS_GetTickCount();
+  Bench_Check("queue_timeout", (OSQueue_Receive(&Bench_Queue, &Msg, 2U) == OS_TIMEOUT) && ((OS_GetTickCount() - Start) >= 2U));
+
+  /* A blocked receiver gets the message sent to it */
+  Bench_Status   = OS_TIMEOUT;
+  Bench_Received = (void *)0;
+
+  OSThread_Start(&Bench_Thread[0], BENCH_PRIO_LOW, &Receiver_Main, Bench_Stack[0], sizeof(Bench_Stack[0]));
+  OS_msDelay(1U);
+
+  (void) OSQueue_Send(&Bench_Queue, &Bench_Msg[0]);
+  OS_msDelay(1U);
+
+  Bench_Check("queue_wakeup", (Bench_Status == OS_OK) && (Bench_Received == &Bench_Msg[0]));
+
+  Bench_StopAll();
+}
+
+
+/*--------------------------------------------------------------
+- @brief Bench_CheckPool
+-
+- @desc Size validation, block size rounding and storage size,
+-       exhaustion of the free list, the allocation timeout and
+-       the hand-over of a freed block to a blocked thread.
+---------------------------------------------------------------*/
+static void Bench_CheckPool(void)
+{
+  uint8_t *Block[BENCH_POOL_BLOCKS];
+  void    *Extra = (void *)0;
+  uint32_t Index;
+  uint32_t Start;
+  bool     Distinct = true;
+
+  Bench_Check("pool_size_zero",  (OSPool_Init(&Bench_Pool, Bench_PoolStorage, 0U, BENCH_POOL_BLOCKS) == OS_ERR_PARAM)
+                                 && (OSPool_Alloc(&Bench_Pool) == (void *)0));
+  Bench_Check("pool_count_zero", (OSPool_Init(&Bench_Pool, Bench_PoolStorage, BENCH_POOL_BLOCK, 0U) == OS_ERR_PARAM)
+                                 && (OSPool_Alloc(&Bench_Pool) == (void *)0));
+
+  Bench_Check("pool_init", OSPool_Init(&Bench_Pool, Bench_PoolStorage, BENCH_POOL_BLOCK, BENCH_POOL_BLOCKS) == OS_OK);
+  Bench_Check("pool_block_size", ((Bench_Pool.BlockSize % sizeof(void *)) == 0U)
+                                 && (Bench_Pool.BlockSize >= BENCH_POOL_BLOCK)
+                                 && (Bench_Pool.BlockSize < (BENCH_POOL_BLOCK + sizeof(void *)))
+                                 && (sizeof(Bench_PoolStorage) == (Bench_Pool.BlockSize * BENCH_POOL_BLOCKS)));
+
+  for (Index = 0U; Index < BENCH_POOL_BLOCKS; ++Index)
+  {
+    Block[Index] = (uint8_t *)OSPool_Alloc(&Bench_Pool);
+    Distinct     = Distinct && (Block[Index] == ((uint8_t *)Bench_PoolStorage + (Index * Bench_Pool.BlockSize)));
+  }
+
+  Bench_Check("pool_alloc", Distinct && (Bench_Pool.NumFree == 0U));
+  Bench_Check("pool_exhausted", OSPool_Alloc(&Bench_Pool) == (void *)0);
+
+  Start = OS_GetTickCount();
+  Bench_Check("pool_timeout", (OSPool_AllocWait(&Bench_Pool, &Extra, 2U) == OS_TIMEOUT) && (Extra == (void *)0) && ((OS_GetTickCount() - Start) >= 2U));
+
+  /* A blocked thread gets the freed block directly */
+  Bench_Status   = OS_TIMEOUT;
+  Bench_Received = (void *)0;
+
+  OSThread_Start(&Bench_Thread[0], BENCH_PRIO_LOW, &Alloc_Main, Bench_Stack[0], sizeof(Bench_Stack[0]));
+  OS_msDelay(1U);
+
+  OSPool_Free(&Bench_Pool, Block[1]);
+  OS_msDelay(1U);
+
+  Bench_Check("pool_handover", (Bench_Status == OS_OK) && (Bench_Received == Block[1]) && (Bench_Pool.NumFree == 0U));
+
+  OSPool_Free(&Bench_Pool, Block[0]);
+  OSPool_Free(&Bench_Pool, Block[2]);
+
+  Bench_Check("pool_free", (Bench_Pool.NumFree == 2U) && (OSPool_Alloc(&Bench_Pool) == Block[2]));
+
+  Bench_StopAll();
+}
+
+
+/*--------------------------------------------------------------
+- @brief Bench_CheckFlags
+-
+- @desc The any/all wait modes with and without consuming the
+-       flags, the timeout, and the wakeup of blocked waiters
+-       only once their own condition is met.
+---------------------------------------------------------------*/
+static void Bench_CheckFlags(void)
+{
+  uint32_t Flags = 0U;
+  uint32_t Start;
+
+  OSEventFlags_Init(&Bench_Flags);
+
+  Bench_Check("flags_empty", OSEventFlags_Wait(&Bench_Flags, 0x1U, OS_FLAGS_ANY, &Flags, OS_NO_WAIT) == OS_TIMEOUT);
+
+  OSEventFlags_Set(&Bench_Flags, 0x1U);
+
+  Bench_Check("flags_any", (OSEventFlags_Wait(&Bench_Flags, 0x3U, OS_FLAGS_ANY, &Flags, OS_NO_WAIT) == OS_OK)
+                           && (Flags == 0x1U) && (Bench_Flags.Flags == 0x1U));
+  Bench_Check("flags_all_missing", OSEventFlags_Wait(&Bench_Flags, 0x3U, OS_FLAGS_ALL, &Flags, OS_NO_WAIT) == OS_TIMEOUT);
+
+  OSEventFlags_Set(&Bench_Flags, 0x6U);
+
+  Bench_Check("flags_all_consume", (OSEventFlags_Wait(&Bench_Flags, 0x3U, OS_FLAGS_ALL | OS_FLAGS_CONSUME, &Flags, OS_NO_WAIT) == OS_OK)
+                                   && (Flags == 0x3U) && (Bench_Flags.Flags == 0x4U));
+
+  OSEventFlags_Clear(&Bench_Flags, 0x4U);
+
+  Start = OS_GetTickCount();
+  Bench_Check("flags_timeout", (OSEventFlags_Wait(&Bench_Flags, 0x1U, OS_FLAGS_ANY, &Flags, 2U) == OS_TIMEOUT)
+                               && (Flags == 0U) && ((OS_GetTickCount() - Start) >= 2U));
+
+  /* Blocked waiters wake up on their own condition only */
+  Bench_FlagsSeen[0] = 0U;
+  Bench_FlagsSeen[1] = 0U;
+
+  OSThread_Start(&Bench_Thread[0], BENCH_PRIO_LOW,      &FlagsAll_Main, Bench_Stack[0], sizeof(Bench_Stack[0]));
+  OSThread_Start(&Bench_Thread[1], BENCH_PRIO_LOW + 1U, &FlagsAny_Main, Bench_Stack[1], sizeof(Bench_Stack[1]));
+  OS_msDelay(1U);
+
+  OSEventFlags_Set(&Bench_Flags, 0x1U);
+  OS_msDelay(1U);
+
+  Bench_Check("flags_wait_all", (Bench_FlagsSeen[0] == 0U) && (Bench_FlagsSeen[1] == 0U));
+
+  OSEventFlags_Set(&Bench_Flags, 0x6U);
+  OS_msDelay(1U);
+
+  Bench_Check("flags_wake", (Bench_FlagsSeen[0] == 0x3U) && (Bench_FlagsSeen[1] == 0x4U) && (Bench_Flags.Flags == 0x4U));
+
+  Bench_StopAll();
+}
+
+
+/*--------------------------------------------------------------
+- @brief Bench_CheckUntil
+-
+- @desc Absolute wakeups: OS_DelayUntil on a future, the current
+-       and a past tick, and the catch-up of OSPeriodic_Wait
+-       after the loop body overran two activations.
+---------------------------------------------------------------*/
+static void Bench_CheckUntil(void)
+{
+  OSPeriodic Periodic;
+  uint32_t   Wake;
+  uint32_t   Missed;
+
+  OS_msDelay(1U);
+  Wake = OS_GetTickCount() + 3U;
+
+  Bench_Check("until_future", (OS_DelayUntil(Wake) == OS_OK) && (OS_GetTickCount() == Wake));
+  Bench_Check("until_now",    (OS_DelayUntil(Wake) == OS_OK) && (OS_GetTickCount() == Wake));
+  Bench_Check("until_past",   (OS_DelayUntil(Wake - 1U) == OS_TIMEOUT) && (OS_GetTickCount() == Wake));
+
+  /* Period 3: on time once, then the body runs past two activations */
+  OSPeriodic_Init(&Periodic, 3U);
+  Wake = Periodic.NextWake;
+
+  Missed = OSPeriodic_Wait(&Periodic);
+  Bench_Check("periodic_on_time", (Missed == 0U) && (OS_GetTickCount() == (Wake + 3U)));
+
+  while ((OS_GetTickCount() - Wake) < 10U)
+  {
+    /* Overrun: busy until 10 ticks after the anchor */
+  }
+
+  Missed = OSPeriodic_Wait(&Periodic);
+  Bench_Check("periodic_catch_up", (Missed == 2U) && (Periodic.Overruns == 2U) && (OS_GetTickCount() == (Wake + 12U)));
+}
+
+
+#if (OS_CFG_TIMERS == 1)
+/*--------------------------------------------------------------
+- @brief Bench_TimerLogExpiry
+-
+- @desc Timer callback: logs the timer number (Arg) and the
+-       ticks since the start of the check as (ticks << 8) | id.
+---------------------------------------------------------------*/
+static void Bench_TimerLogExpiry(void *Arg)
+{
+  if (Bench_TimerCount < BENCH_TIMER_EVENTS)
+  {
+    Bench_TimerLog[Bench_TimerCount] = ((OS_GetTickCount() - Bench_TimerStart) << 8U) | (uint32_t)(uintptr_t)Arg;
+  }
+
+  ++Bench_TimerCount;
+}
+
+
+/*--------------------------------------------------------------
+- @brief Bench_CheckTimers
+-
+- @desc Expiry order and ticks of one-shot and periodic timers,
+-       including two timers with the same deadline (in start
+-       order) and a timer stopped before it expires.
+---------------------------------------------------------------*/
+static void Bench_CheckTimers(void)
+{
+  /* (ticks << 8) | timer: 1 and 3 share tick 5, 4 is periodic (3 ticks), 5 is stopped */
+  static const uint32_t Expected[] = { 0x202U, 0x304U, 0x501U, 0x503U, 0x604U, 0x904U };
+  uint32_t Index;
+  bool     Order = true;
+
+  for (Index = 0U; Index < 5U; ++Index)
+  {
+    OSTimer_Init(&Bench_Timer[Index], &Bench_TimerLogExpiry, (void *)(uintptr_t)(Index + 1U));
+  }
+
+  Bench_TimerCount = 0U;
+  OS_msDelay(1U);
+  Bench_TimerStart = OS_GetTickCount();
+
+  OSTimer_Start(&Bench_Timer[0], 5U, 0U);
+  OSTimer_Start(&Bench_Timer[1], 2U, 0U);
+  OSTimer_Start(&Bench_Timer[2], 5U, 0U);
+  OSTimer_Start(&Bench_Timer[3], 3U, 3U);
+  OSTimer_Start(&Bench_Timer[4], 4U, 0U);
+  OSTimer_Stop (&Bench_Timer[4]);
+
+  OS_msDelay(10U);
+  OSTimer_Stop(&Bench_Timer[3]);
+
+  for (Index = 0U; Index < (sizeof(Expected) / sizeof(Expected[0])); ++Index)
+  {
+    Order = Order && (Bench_TimerLog[Index] == Expected[Index]);
+  }
+
+  Bench_Check("timer_order", Order && (Bench_TimerCount == (sizeof(Expected) / sizeof(Expected[0]))));
+  Bench_Check("timer_active", !OSTimer_IsActive(&Bench_Timer[0]) && !OSTimer_IsActive(&Bench_Timer[3]));
+}
+#endif
+
+
+/*--------------------------------------------------------------
+- @brief Control_Main
+-
+- @desc Runs the benchmark phases one after another at the highest
+-       priority, prints the results and exits the process.
+---------------------------------------------------------------*/
+void Control_Main(void)
+{
+  Gpt_TickStatsType Before;
+  Gpt_TickStatsType After;
+  uint32_t Start;
+  uint32_t Index;
+  uint32_t Round;
+  uint32_t MinLoops;
+  uint32_t MaxLoops;
+  uint32_t Elapsed;
+
+  /* Context switch time: hand a token back and forth with a lower-priority thread */
+  OSSem_Init(&Bench_Ping, 0U);
+  OSSem_Init(&Bench_Pong, 0U);
+
+  OSThread_Start(&Bench_Thread[0], BENCH_PRIO_LOW, &Pong_Main, Bench_Stack[0], sizeof(Bench_Stack[0]));
+
+  Start = DWT_CYCCNT;
+
+  for (Round = 0U; Round < BENCH_SWITCH_ROUNDS; ++Round)
+  {
+    OSSem_Post(&Bench_Ping);
+    (void) OSSem_Pend(&Bench_Pong, OS_WAIT_FOREVER);
+  }
+
+  Bench_Report("switch_time", (uint64_t)(DWT_CYCCNT - Start) / (BENCH_SWITCH_ROUNDS * 2U), "ns");
+  Bench_StopAll();
+
+  /* Post-to-wakeup latency of a higher-priority thread */
+  OSSem_Init(&Bench_Ping, 0U);
+  OSSem_Init(&Bench_Pong, 0U);
+
+  OSThread_Start(&Bench_Thread[0], BENCH_PRIO_HIGH, &Waiter_Main, Bench_Stack[0], sizeof(Bench_Stack[0]));
+  OSThread_Start(&Bench_Thread[1], BENCH_PRIO_LOW,  &Poster_Main, Bench_Stack[1], sizeof(Bench_Stack[1]));
+
+  (void) OSSem_Pend(&Bench_Pong, OS_WAIT_FOREVER);
+
+  Bench_Report("wakeup_latency_avg", Bench_LatencySum / BENCH_LATENCY_ROUNDS, "ns");
+  Bench_Report("wakeup_latency_max", Bench_LatencyMax, "ns");
+  Bench_StopAll();
+
+  /* Tick handler cost with a populated delayed list */
+  for (Index = 0U; Index < BENCH_DELAYED_THREADS; ++Index)
+  {
+    OSThread_Start(&Bench_Thread[Index], BENCH_PRIO_LOW, &Delayed_Main, Bench_Stack[Index], sizeof(Bench_Stack[Index]));
+  }
+
+  Gpt_GetTickStats(&Before);
+  OS_msDelay(BENCH_RUN_TICKS);
+  Gpt_GetTickStats(&After);
+
+  Bench_Report("tick_isr_avg", (After.IsrCycles - Before.IsrCycles) / (After.IsrCount - Before.IsrCount), "ns");
+  Bench_StopAll();
+
+  /* Round robin among busy threads of equal priority */
+  for (Index = 0U; Index < BENCH_RR_THREADS; ++Index)
+  {
+    OSThread_Start(&Bench_Thread[Index], BENCH_PRIO_LOW, &Busy_Main, Bench_Stack[Index], sizeof(Bench_Stack[Index]));
+  }
+
+  OS_msDelay(BENCH_RUN_TICKS);
+  Bench_StopAll();
+
+  MinLoops = Bench_Loops[0];
+  MaxLoops = Bench_Loops[0];
+
+  for (Index = 1U; Index < BENCH_RR_THREADS; ++Index)
+  {
+    MinLoops = (Bench_Loops[Index] < MinLoops) ? Bench_Loops[Index] : MinLoops;
+    MaxLoops = (Bench_Loops[Index] > MaxLoops) ? Bench_Loops[Index] : MaxLoops;
+  }
+
+  Bench_Report("round_robin_fairness", (MaxLoops != 0U) ? ((uint64_t)MinLoops * 100U) / MaxLoops : 0U, "%");
+
+  /* A zero delay queued in front of this thread must not delay its wakeup */
+  OS_msDelay(1U);
+  OSThread_Start(&Bench_Thread[0], BENCH_PRIO_HIGH, &Yield_Main, Bench_Stack[0], sizeof(Bench_Stack[0]));
+
+  Start   = OS_GetTickCount();
+  OS_msDelay(BENCH_ZERO_DELAY_TICKS);
+  Elapsed = OS_GetTickCount() - Start;
+  Bench_StopAll();
+
+  Bench_Report("zero_delay_late", (Elapsed > BENCH_ZERO_DELAY_TICKS) ? (Elapsed - BENCH_ZERO_DELAY_TICKS) : 0U, "ticks");
+  Bench_Check("zero_delay", Elapsed == BENCH_ZERO_DELAY_TICKS);
+
+  /* Pass/fail checks of the kernel objects */
+  Bench_CheckMutex();
+  Bench_CheckQueue();
+  Bench_CheckPool();
+  Bench_CheckFlags();
+  Bench_CheckUntil();
+
+#if (OS_CFG_TIMERS == 1)
+  Bench_CheckTimers();
+#endif
+
+  exit(EXIT_SUCCESS);
+}
+
+
+/*--------------------------------------------------------------
+- Main
+---------------------------------------------------------------*/
+int main(void)
+{
+  SystemInit();
+  SysTick_Init();
+
+  OS_Init(IdleThread_Stack, sizeof(IdleThread_Stack));
+
+  OSThread_Start(&Control_Thread,
+                 BENCH_PRIO_CONTROL,
+                 &Control_Main,
+                 Control_Stack,
+                 sizeof(Control_Stack));
+
+  OS_Run();
+
+  return 0;
+}
@@ -0,0 +1,103 @@
+#include <time.h>
+#include <Mcal/Gpt.h>
+#include <Mcal/Mcu.h>
+#include <OS/Os.h>
+
+/*----------------------------------------------------------------------------
+- Microsecond time base (OS_CFG_HR_TIME); the millisecond counter and
+- SysTick_Handler are in Target/Common/Mcal/GptTick.c
+-----------------------------------------------------------------------------*/
+
+#if (OS_CFG_HR_TIME == 1)
+/*----------------------------------------------------------------------------
+- File-Local Variables
+-----------------------------------------------------------------------------*/
+static uint32_t Gpt_HrAlarm;
+static bool     Gpt_HrArmed;
+
+
+/*----------------------------------------------------------------------------
+- @brief Gpt_HrInit
+-
+- @desc Nothing to start on the host: the microsecond counter is derived
+  from the monotonic clock.
+-
+- @param void
+- @return void
+-----------------------------------------------------------------------------*/
+void Gpt_HrInit(void)
+{
+  Gpt_HrArmed = false;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief Gpt_HrGetTime
+-
+- @desc Returns the monotonic clock in microseconds (wraps around after
+  2^32 us).
+-
+- @param void
+- @return uint32_t  Time in microseconds
+-----------------------------------------------------------------------------*/
+uint32_t Gpt_HrGetTime(void)
+{
+  struct timespec Now;
+
+  (void) clock_gettime(CLOCK_MONOTONIC, &Now);
+
+  return (uint32_t)(((uint64_t)Now.tv_sec * 1000000ULL) + ((uint64_t)Now.tv_nsec / 1000ULL));
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief Gpt_HrStartAlarm
+-
+- @desc Arms the alarm, served by the next SysTick at or after Time.
+  Must be called in a critical section.
+-
+- @param Time   Microsecond time of the alarm
+- @return void
+-----------------------------------------------------------------------------*/
+void Gpt_HrStartAlarm(const uint32_t Time)
+{
+  Gpt_HrAlarm = Time;
+  Gpt_HrArmed = true;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief Gpt_HrStopAlarm
+-
+- @desc Disarms the alarm.
+  Must be called in a critical section.
+-
+- @param void
+- @return void
+-----------------------------------------------------------------------------*/
+void Gpt_HrStopAlarm(void)
+{
+  Gpt_HrArmed = false;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief Gpt_HrPollAlarm
+-
+- @desc Emulated compare interrupt of the microsecond counter, run by the
+  SIGALRM handler before SysTick_Handler: wakes the threads whose
+  microsecond delay has expired.
+-
+- @param void
+- @return void
+-----------------------------------------------------------------------------*/
+void Gpt_HrPollAlarm(void)
+{
+  if (Gpt_HrArmed && ((int32_t)(Gpt_HrAlarm - Gpt_HrGetTime()) <= 0))
+  {
+    Gpt_HrArmed = false;
+
+    OS_HrAlarm();
+  }
+}
+#endif
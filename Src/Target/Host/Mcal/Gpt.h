@@ -0,0 +1,26 @@
+#ifndef GPT_2026_10_17_H
+  #define GPT_2026_10_17_H
+
+  #include <stdint.h>
+
+  #include <Target/Common/Mcal/GptTick.h>
+
+  /* High-resolution time base (OS_CFG_HR_TIME): monotonic clock in microseconds,
+     the alarm is checked by each SysTick (1 ms resolution on the host) */
+
+  /* Starts the microsecond counter. */
+  void Gpt_HrInit(void);
+
+  /* Returns the microsecond counter (wraps around after 2^32 us). */
+  uint32_t Gpt_HrGetTime(void);
+
+  /* Arms the alarm for an absolute microsecond time. */
+  void Gpt_HrStartAlarm(const uint32_t Time);
+
+  /* Disarms the alarm. */
+  void Gpt_HrStopAlarm(void);
+
+  /* Emulated compare interrupt: serves an expired alarm (SIGALRM handler). */
+  void Gpt_HrPollAlarm(void);
+
+#endif /* GPT_2026_10_17_H */
@@ -0,0 +1,302 @@
+#include <signal.h>
+#include <stdbool.h>
+#include <sys/time.h>
+#include <time.h>
+
+#include <Mcal/Gpt.h>
+#include <Mcal/Mcu.h>
+#include <OS/OsCfg.h>
+
+/*----------------------------------------------------------------------------
+- Global Variables
+-----------------------------------------------------------------------------*/
+volatile uint32_t Host_Icsr;
+
+/*----------------------------------------------------------------------------
+- File-Local Variables
+-----------------------------------------------------------------------------*/
+static sigset_t          Host_IrqSet;       /* SIGALRM: the emulated SysTick */
+static volatile uint32_t Host_IsrNesting;   /* SysTick signal handler active */
+
+
+/*----------------------------------------------------------------------------
+- Function Declarations
+-----------------------------------------------------------------------------*/
+void SysTick_Handler(void);
+void PendSV_Handler (void);
+static void Host_SysTickIsr(int Sig);
+static void Host_TakePendSV(void);
+
+
+/*----------------------------------------------------------------------------
+- @brief SystemInit
+-
+- @desc Prepares the interrupt emulation: SIGALRM stands for the SysTick.
+-
+- @param void
+- @return void
+-----------------------------------------------------------------------------*/
+void SystemInit(void)
+{
+  (void) sigemptyset(&Host_IrqSet);
+  (void) sigaddset  (&Host_IrqSet, SIGALRM);
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief SetSysClock
+-
+- @desc Nothing to configure on the host.
+-
+- @param void
+- @return void
+-----------------------------------------------------------------------------*/
+void SetSysClock(void)
+{
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief SysTick_Init
+-
+- @desc Installs the SysTick signal handler and starts a 1 ms interval
+-       timer.
+-
+- @param void
+- @return void
+-----------------------------------------------------------------------------*/
+void SysTick_Init(void)
+{
+  struct sigaction Action;
+  struct itimerval Timer;
+
+  Action.sa_handler = &Host_SysTickIsr;
+  Action.sa_flags   = SA_RESTART;
+  (void) sigemptyset(&Action.sa_mask);
+  (void) sigaction(SIGALRM, &Action, (struct sigaction *)0);
+
+  Timer.it_interval.tv_sec  = 0;
+  Timer.it_interval.tv_usec = 1000;
+  Timer.it_value            = Timer.it_interval;
+  (void) setitimer(ITIMER_REAL, &Timer, (struct itimerval *)0);
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief Host_SysTickIsr
+-
+- @desc SIGALRM handler: serves the emulated microsecond alarm, runs
+-       SysTick_Handler and, like an exception return, then takes a
+-       pending PendSV. A context switch from here
+-       leaves the signal frame on the stack of the preempted thread; it
+-       returns from the signal when it is switched back in.
+-
+- @param Sig   Signal number (unused)
+- @return void
+-----------------------------------------------------------------------------*/
+static void Host_SysTickIsr(int Sig)
+{
+  (void) Sig;
+
+  ++Host_IsrNesting;
+
+#if (OS_CFG_HR_TIME == 1)
+  Gpt_HrPollAlarm();
+#endif
+
+  SysTick_Handler();
+
+  --Host_IsrNesting;
+
+  Host_TakePendSV();
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief Host_TakePendSV
+-
+- @desc Runs PendSV_Handler while the PendSV pending bit is set.
+-       Called with SIGALRM blocked.
+-
+- @param void
+- @return void
+-----------------------------------------------------------------------------*/
+static void Host_TakePendSV(void)
+{
+  while ((ICSR & ICSR_PENDSVSET) != 0U)
+  {
+    ICSR &= ~ICSR_PENDSVSET;
+
+    PendSV_Handler();
+  }
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief Dwt_Init
+-
+- @desc The cycle counter is emulated by the monotonic clock.
+-
+- @param void
+- @return void
+-----------------------------------------------------------------------------*/
+void Dwt_Init(void)
+{
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief Host_CycleCounter
+-
+- @desc Emulates DWT_CYCCNT: a free-running 32-bit nanosecond counter.
+-
+- @param void
+- @return uint32_t  Monotonic time in nanoseconds (wraps around)
+-----------------------------------------------------------------------------*/
+uint32_t Host_CycleCounter(void)
+{
+  struct timespec Now;
+
+  (void) clock_gettime(CLOCK_MONOTONIC, &Now);
+
+  return (uint32_t)(((uint64_t)Now.tv_sec * 1000000000ULL) + (uint64_t)Now.tv_nsec);
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief SysTick_StartOneShot / SysTick_StopOneShot
+-
+- @desc The interval timer is not reprogrammed on the host: tickless idle
+-       falls back to waiting tick by tick.
+-----------------------------------------------------------------------------*/
+bool SysTick_StartOneShot(uint32_t Ticks)
+{
+  (void) Ticks;
+
+  return false;
+}
+
+uint32_t SysTick_StopOneShot(void)
+{
+  return 0U;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief NVIC_SetPriority
+-
+- @desc Interrupt priorities are not emulated (SIGALRM is the only one).
+-
+- @param IRQn     : IRQ number (unused)
+- @param Priority : Priority value (unused)
+- @return void
+-----------------------------------------------------------------------------*/
+void NVIC_SetPriority(int32_t IRQn, uint32_t Priority)
+{
+  (void) IRQn;
+  (void) Priority;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief Wait_For_Interrupt
+-
+- @desc Sleeps until the next SysTick signal. With interrupts disabled the
+-       signal only wakes the CPU: it is taken again and stays pending
+-       until interrupts are enabled, as on the target.
+-----------------------------------------------------------------------------*/
+void Wait_For_Interrupt(void)
+{
+  sigset_t Masked;
+
+  (void) sigprocmask(SIG_BLOCK, (sigset_t *)0, &Masked);
+
+  if (sigismember(&Masked, SIGALRM) == 1)
+  {
+    int Sig;
+
+    (void) sigwait(&Host_IrqSet, &Sig);
+    (void) raise(Sig);
+  }
+  else
+  {
+    sigset_t None;
+
+    (void) sigemptyset(&None);
+    (void) sigsuspend(&None);
+  }
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief Enable_Irq
+-
+- @desc Takes a pending PendSV, then unblocks the SysTick signal. Inside
+-       the SysTick handler interrupts stay masked until it returns.
+-----------------------------------------------------------------------------*/
+void Enable_Irq(void)
+{
+  if (Host_IsrNesting == 0U)
+  {
+    Host_TakePendSV();
+
+    (void) sigprocmask(SIG_UNBLOCK, &Host_IrqSet, (sigset_t *)0);
+  }
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief Disable_Irq
+-
+- @desc Blocks the SysTick signal.
+-----------------------------------------------------------------------------*/
+void Disable_Irq(void)
+{
+  if (Host_IsrNesting == 0U)
+  {
+    (void) sigprocmask(SIG_BLOCK, &Host_IrqSet, (sigset_t *)0);
+  }
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief Mask_Irq
+-
+- @desc Blocks the SysTick signal, the only emulated interrupt, whatever
+-       the priority. Nests like BASEPRI on the target.
+-
+- @param Priority : Priority value (unused)
+- @return uint32_t : 1 if interrupts were masked already, 0 otherwise
+-----------------------------------------------------------------------------*/
+uint32_t Mask_Irq(uint32_t Priority)
+{
+  sigset_t Masked;
+
+  (void) Priority;
+
+  if (Host_IsrNesting != 0U)
+  {
+    return 1U;
+  }
+
+  (void) sigprocmask(SIG_BLOCK, &Host_IrqSet, &Masked);
+
+  return (sigismember(&Masked, SIGALRM) == 1) ? 1U : 0U;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief Restore_Irq
+-
+- @desc Enables interrupts again if the matching Mask_Irq masked them.
+-
+- @param Mask : Previous mask
+- @return void
+-----------------------------------------------------------------------------*/
+void Restore_Irq(uint32_t Mask)
+{
+  if (Mask == 0U)
+  {
+    Enable_Irq();
+  }
+}
@@ -0,0 +1,59 @@
+#ifndef MCU_2026_10_17_H
+  #define MCU_2026_10_17_H
+
+  #include <stdbool.h>
+  #include <stdint.h>
+
+  /*----------------------------------------------------------------------------
+  - Host (Linux) emulation of the MCU layer
+  -
+  - The SysTick is a 1 ms SIGALRM interval timer, masking interrupts blocks
+  - SIGALRM and the PendSV pending bit in ICSR is taken when interrupts are
+  - enabled again or when the SysTick signal handler returns.
+  -----------------------------------------------------------------------------*/
+  typedef enum
+  {
+    PendSV_IRQn                 = -2,     /*   14 Pend SV Interrupt (emulated)                                     */
+    SysTick_IRQn                = -1      /*   15 System Tick Interrupt (SIGALRM)                                  */
+  }IRQn_Type;
+
+  /* No separate fast memory on the host */
+  #define MCU_RAMFUNC
+
+  /* No memory map on the host: stacks, DMA buffers and no-init data are ordinary data */
+  #define MCU_THREAD_STACK       __attribute__((aligned(8)))
+  #define MCU_DMA_BUFFER
+  #define MCU_NOINIT
+
+  /* Emulated interrupt control and state register */
+  extern volatile uint32_t Host_Icsr;
+
+  #define ICSR                 Host_Icsr
+  #define ICSR_PENDSTSET       ((uint32_t)1U << 26U)
+  #define ICSR_PENDSVSET       ((uint32_t)1U << 28U)
+
+  /* No one-shot SysTick on the host: tickless idle keeps the 1 ms tick */
+  #define STK_MAX_IDLE_TICKS   (1UL)
+
+  /* Cycle counter emulated by the monotonic clock (nanoseconds) */
+  #define DWT_CYCCNT           (Host_CycleCounter())
+
+  /* Functions prototypes */
+  void SystemInit        (void);
+  void SetSysClock       (void);
+  void SysTick_Init      (void);
+  void Dwt_Init          (void);
+  void Enable_Irq        (void);
+  void Disable_Irq       (void);
+  uint32_t Mask_Irq      (uint32_t Priority);
+  void Restore_Irq       (uint32_t Mask);
+  void Wait_For_Interrupt(void);
+
+  void NVIC_SetPriority(int32_t IRQn, uint32_t priority);
+
+  bool     SysTick_StartOneShot(uint32_t Ticks);
+  uint32_t SysTick_StopOneShot (void);
+
+  uint32_t Host_CycleCounter(void);
+
+#endif // MCU_2026_10_17_H
@@ -0,0 +1,150 @@
+#include <signal.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <ucontext.h>
+#include "Mcal/Mcu.h"
+#include "OS/Os.h"
+#include "OS/OsTrace.h"
+#include "OsPort.h"
+
+
+/*----------------------------------------------------------------------------
+- Port Types
+-----------------------------------------------------------------------------*/
+
+/* Saved context of a thread, kept at the top of its stack */
+typedef struct
+{
+  ucontext_t      Context;            /* Registers and signal mask (MyStckPointer points here) */
+  OSThreadHandler ThreadHandler;      /* Entry function */
+  void          (*ThreadExit)(void);  /* Called when the entry function returns */
+} OSPort_ThreadContext;
+
+
+/*----------------------------------------------------------------------------
+- Port Function Declarations
+-----------------------------------------------------------------------------*/
+void PendSV_Handler(void);
+static void OSPort_ThreadEntry(void);
+
+
+/*----------------------------------------------------------------------------
+- @brief OSPort_Init
+
+- @desc Nothing to set up: the Mcal emulation runs PendSV_Handler when
+        interrupts are enabled or when the SysTick signal handler returns.
+
+- @param void
+
+- @return void
+-----------------------------------------------------------------------------*/
+void OSPort_Init(void)
+{
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSPort_StackInit
+
+- @desc Places the saved context of a thread at the top of its stack and
+        prepares it to start in OSPort_ThreadEntry on the rest of the
+        stack, with the SysTick signal unblocked (interrupts enabled).
+        The stack must also hold the signal frames of the SysTick.
+
+- @param TCB            Thread control block (StkLimit already set)
+         ThreadHandler  Entry function of the thread
+         ThreadExit     Called when the entry function returns
+         StckTop        Top of the stack
+
+- @return void
+-----------------------------------------------------------------------------*/
+void OSPort_StackInit(OSThread *TCB, OSThreadHandler ThreadHandler, void (*ThreadExit)(void), uint32_t *StckTop)
+{
+  OSPort_ThreadContext *Thread = (OSPort_ThreadContext *)
+    (((uintptr_t)StckTop - sizeof(OSPort_ThreadContext)) & ~(uintptr_t)15U);
+
+  (void) getcontext(&Thread->Context);
+
+  Thread->Context.uc_stack.ss_sp   = TCB->StkLimit;
+  Thread->Context.uc_stack.ss_size = (size_t)((uintptr_t)Thread - (uintptr_t)TCB->StkLimit);
+  Thread->Context.uc_link          = (ucontext_t *)0;
+  (void) sigemptyset(&Thread->Context.uc_sigmask);
+
+  makecontext(&Thread->Context, &OSPort_ThreadEntry, 0);
+
+  Thread->ThreadHandler = ThreadHandler;
+  Thread->ThreadExit    = ThreadExit;
+
+  TCB->MyStckPointer    = Thread;
+  TCB->ExcReturn        = 0U;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSPort_ThreadEntry
+
+- @desc First function of every thread: calls the entry function of the
+        current thread and its exit function when it returns.
+
+- @param void
+
+- @return void
+-----------------------------------------------------------------------------*/
+static void OSPort_ThreadEntry(void)
+{
+  const OSPort_ThreadContext *Thread = (const OSPort_ThreadContext *)OS_Curr->MyStckPointer;
+
+  Thread->ThreadHandler();
+  Thread->ThreadExit();
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief PendSV_Handler
+
+- @desc Emulated context switch: saves the context of OS_Curr, restores
+        the one of OS_Next and updates OS_Curr. The signal mask is part of
+        the context, so each thread resumes with its own interrupt state.
+        With OS_CFG_STACK_CHECK the lowest stack word of the thread
+        switched out must still hold the fill pattern.
+
+- @param void
+
+- @return void
+-----------------------------------------------------------------------------*/
+void PendSV_Handler(void)
+{
+  OSThread *const Prev = OS_Curr;
+  OSThread *const Next = OS_Next;
+
+#if (OS_CFG_THREAD_STATS == 1)
+  OS_StatsSwitch();
+#endif
+
+#if (OS_CFG_TRACE == 1)
+  OS_TraceSwitch();
+#endif
+
+  OS_Curr = Next;
+
+  if (Prev == (OSThread *)0)
+  {
+    (void) setcontext(&((OSPort_ThreadContext *)Next->MyStckPointer)->Context);
+  }
+  else if (Prev != Next)
+  {
+#if (OS_CFG_STACK_CHECK == 1)
+    if (*Prev->StkLimit != 0xFACEB00CUL)
+    {
+      OS_OnStackOverflow(Prev);
+    }
+#endif
+
+    (void) swapcontext(&((OSPort_ThreadContext *)Prev->MyStckPointer)->Context,
+                       &((OSPort_ThreadContext *)Next->MyStckPointer)->Context);
+  }
+  else
+  {
+    /* Switch back to the current thread: nothing to do */
+  }
+}
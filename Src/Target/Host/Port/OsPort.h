@@ -0,0 +1,18 @@
+#ifndef OS_PORT_2026_10_17_H
+  #define OS_PORT_2026_10_17_H
+
+  #include <stdint.h>
+
+  #include "OS/Os.h"
+
+  /*----------------------------------------------------------------------------
+  - OS port for the Linux host: ucontext switching in an emulated PendSV
+  -----------------------------------------------------------------------------*/
+
+  /* Sets up the context switch */
+  void OSPort_Init(void);
+
+  /* Builds the initial context of a thread below the top of its stack */
+  void OSPort_StackInit(OSThread *TCB, OSThreadHandler ThreadHandler, void (*ThreadExit)(void), uint32_t *StckTop);
+
+#endif /* OS_PORT_2026_10_17_H */
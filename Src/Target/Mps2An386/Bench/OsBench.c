@@ -0,0 +1,349 @@
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <Mcal/Gpio.h>
+#include <Mcal/Gpt.h>
+#include <Mcal/Mcu.h>
+#include <Mcal/Semihost.h>
+#include <OS/Os.h>
+#include <OS/OsSem.h>
+
+/*--------------------------------------------------------------
+- Benchmark Configuration
+---------------------------------------------------------------*/
+#define BENCH_STACK_WORDS       (256U)         /* 1 KB per thread */
+#define BENCH_ROUNDS            (64UL)         /* samples averaged per result */
+#define BENCH_MAX_DELAYED       (32U)          /* largest delayed list in the tick benchmark */
+#define BENCH_TICK_RUN          (16UL)         /* SysTick interrupts sampled per delayed list size */
+#define BENCH_DELAY_FOREVER     (0x7FFFFFFFUL) /* delay that does not expire during the run */
+
+#define BENCH_PRIO_CONTROL      (30U)
+#define BENCH_PRIO_LOW          (10U)
+#define BENCH_PRIO_PROBE        (1U)
+
+#define BENCH_NUM_THREADS       (BENCH_MAX_DELAYED + 1U)
+
+#define BENCH_NUM_SIZES         (3U)
+
+/*--------------------------------------------------------------
+- Global Variables
+---------------------------------------------------------------*/
+MCU_THREAD_STACK uint32_t IdleThread_Stack[BENCH_STACK_WORDS];
+MCU_THREAD_STACK uint32_t Control_Stack   [BENCH_STACK_WORDS];
+MCU_THREAD_STACK uint32_t Bench_Stack     [BENCH_NUM_THREADS][BENCH_STACK_WORDS];
+
+OSThread Control_Thread;
+OSThread Bench_Thread[BENCH_NUM_THREADS];
+
+static OSSem             Bench_Ping;
+static OSSem             Bench_Pong;
+static uint32_t          Bench_Overhead;
+static volatile bool     Bench_ProbeStarted;
+static volatile uint32_t Bench_ProbeFirst;
+static volatile uint32_t Bench_ProbeLast;
+
+/* Delayed list sizes of the tick benchmark and their result names */
+static const uint32_t    Bench_Delayed [BENCH_NUM_SIZES] = { 0U, 8U, BENCH_MAX_DELAYED };
+static const char *const Bench_TickName[BENCH_NUM_SIZES] = { "os_tick_0",  "os_tick_8",  "os_tick_32"  };
+static const char *const Bench_IsrName [BENCH_NUM_SIZES] = { "tick_isr_0", "tick_isr_8", "tick_isr_32" };
+
+
+/*--------------------------------------------------------------
+- Function Declarations
+---------------------------------------------------------------*/
+void Control_Main (void);
+void Pong_Main    (void);
+void Delayed_Main (void);
+void Probe_Main   (void);
+
+void HardFault_Handler (void);
+
+static void     Bench_Report  (const char *Name, uint32_t Value, const char *Unit);
+static void     Bench_StopAll (void);
+static uint32_t Bench_Elapsed (uint32_t Start);
+
+
+/*--------------------------------------------------------------
+- @brief Bench_Report
+-
+- @desc Prints one result as "BENCH <name> <value> <unit>" over
+-       semihosting.
+---------------------------------------------------------------*/
+static void Bench_Report(const char *Name, uint32_t Value, const char *Unit)
+{
+  char     Line[80];
+  char     Digits[10];
+  uint32_t Pos   = 0U;
+  uint32_t Count = 0U;
+
+  for (const char *Src = "BENCH "; *Src != '\0'; ++Src) { Line[Pos++] = *Src; }
+  for (const char *Src = Name;     *Src != '\0'; ++Src) { Line[Pos++] = *Src; }
+
+  Line[Pos++] = ' ';
+
+  do
+  {
+    Digits[Count++] = (char)('0' + (Value % 10U));
+    Value /= 10U;
+  } while (Value != 0U);
+
+  while (Count != 0U) { Line[Pos++] = Digits[--Count]; }
+
+  Line[Pos++] = ' ';
+
+  for (const char *Src = Unit; *Src != '\0'; ++Src) { Line[Pos++] = *Src; }
+
+  Line[Pos++] = '\n';
+  Line[Pos]   = '\0';
+
+  Semihost_Write0(Line);
+}
+
+
+/*--------------------------------------------------------------
+- @brief Bench_StopAll
+-
+- @desc Stops the benchmark threads of the previous phase.
+---------------------------------------------------------------*/
+static void Bench_StopAll(void)
+{
+  uint32_t Index;
+
+  for (Index = 0U; Index < BENCH_NUM_THREADS; ++Index)
+  {
+    OSThread_Stop(&Bench_Thread[Index]);
+  }
+}
+
+
+/*--------------------------------------------------------------
+- @brief Bench_Elapsed
+-
+- @desc Returns the cycles since Start without the cost of reading
+-       the cycle counter.
+---------------------------------------------------------------*/
+static uint32_t Bench_Elapsed(uint32_t Start)
+{
+  const uint32_t Cycles = DWT_CYCCNT - Start;
+
+  return (Cycles > Bench_Overhead) ? (Cycles - Bench_Overhead) : 0U;
+}
+
+
+/*--------------------------------------------------------------
+- Benchmark Threads
+---------------------------------------------------------------*/
+
+/* Context switch: returns the token of Control_Main */
+void Pong_Main(void)
+{
+  while (1U)
+  {
+    (void) OSSem_Pend(&Bench_Ping, OS_WAIT_FOREVER);
+    OSSem_Post(&Bench_Pong);
+  }
+}
+
+/* Tick load: threads parked in the delayed list */
+void Delayed_Main(void)
+{
+  while (1U)
+  {
+    OS_msDelay(BENCH_DELAY_FOREVER);
+  }
+}
+
+/* Delay round trip: runs while Control_Main sleeps and stamps the
+   first and the last cycle it got */
+void Probe_Main(void)
+{
+  while (1U)
+  {
+    const uint32_t Now = DWT_CYCCNT;
+
+    if (!Bench_ProbeStarted)
+    {
+      Bench_ProbeFirst   = Now;
+      Bench_ProbeStarted = true;
+    }
+
+    Bench_ProbeLast = Now;
+  }
+}
+
+
+/*--------------------------------------------------------------
+- @brief Control_Main
+-
+- @desc Runs the benchmark phases one after another at the highest
+-       priority, prints the results and stops the emulator.
+---------------------------------------------------------------*/
+void Control_Main(void)
+{
+  Gpt_TickStatsType Before;
+  Gpt_TickStatsType After;
+  uint32_t Start;
+  uint32_t Sum;
+  uint32_t Suspend;
+  uint32_t Resume;
+  uint32_t Index;
+  uint32_t Size;
+  uint32_t Round;
+
+  /* Reset to the first thread dispatch (counted from the startup code) */
+  Bench_Report("boot_cycles", OS_GetBootCycles(), "cyc");
+
+  /* Cost of reading the cycle counter, subtracted from every sample */
+  Bench_Overhead = 0xFFFFFFFFUL;
+
+  for (Round = 0U; Round < BENCH_ROUNDS; ++Round)
+  {
+    Start = DWT_CYCCNT;
+    Sum   = DWT_CYCCNT - Start;
+
+    Bench_Overhead = (Sum < Bench_Overhead) ? Sum : Bench_Overhead;
+  }
+
+  /* PendSV_Handler: a switch from the running thread to itself
+     (exception entry, save, restore and exception return) */
+  for (Round = 0U, Sum = 0U; Round < BENCH_ROUNDS; ++Round)
+  {
+    Start = DWT_CYCCNT;
+    ICSR  = ICSR_PENDSVSET;
+    __asm volatile ("dsb\n isb" ::: "memory");
+    Sum  += Bench_Elapsed(Start);
+  }
+
+  Bench_Report("pendsv_handler", Sum / BENCH_ROUNDS, "cyc");
+
+  /* OS_Sched: scheduling decision without a switch */
+  for (Round = 0U, Sum = 0U; Round < BENCH_ROUNDS; ++Round)
+  {
+    Disable_Irq();
+    Start = DWT_CYCCNT;
+    OS_Sched();
+    Sum  += Bench_Elapsed(Start);
+    Enable_Irq();
+  }
+
+  Bench_Report("os_sched", Sum / BENCH_ROUNDS, "cyc");
+
+  /* Semaphore ping-pong with a lower-priority thread (2 switches per round) */
+  OSSem_Init(&Bench_Ping, 0U);
+  OSSem_Init(&Bench_Pong, 0U);
+
+  OSThread_Start(&Bench_Thread[0], BENCH_PRIO_LOW, &Pong_Main, Bench_Stack[0], sizeof(Bench_Stack[0]));
+
+  Start = DWT_CYCCNT;
+
+  for (Round = 0U; Round < BENCH_ROUNDS; ++Round)
+  {
+    OSSem_Post(&Bench_Ping);
+    (void) OSSem_Pend(&Bench_Pong, OS_WAIT_FOREVER);
+  }
+
+  Bench_Report("sem_switch", Bench_Elapsed(Start) / (BENCH_ROUNDS * 2U), "cyc");
+  Bench_StopAll();
+
+  /* OS_Tick and the whole SysTick_Handler with N delayed threads */
+  for (Size = 0U; Size < BENCH_NUM_SIZES; ++Size)
+  {
+    for (Index = 0U; Index < Bench_Delayed[Size]; ++Index)
+    {
+      OSThread_Start(&Bench_Thread[Index], BENCH_PRIO_LOW, &Delayed_Main, Bench_Stack[Index], sizeof(Bench_Stack[Index]));
+    }
+
+    /* Let the threads enter the delayed list */
+    OS_msDelay(1U);
+
+    for (Round = 0U, Sum = 0U; Round < BENCH_ROUNDS; ++Round)
+    {
+      Disable_Irq();
+      Start = DWT_CYCCNT;
+      OS_Tick();
+      Sum  += Bench_Elapsed(Start);
+      Enable_Irq();
+    }
+
+    Bench_Report(Bench_TickName[Size], Sum / BENCH_ROUNDS, "cyc");
+
+    Gpt_GetTickStats(&Before);
+    OS_msDelay(BENCH_TICK_RUN);
+    Gpt_GetTickStats(&After);
+
+    Bench_Report(Bench_IsrName[Size], (uint32_t)(After.IsrCycles - Before.IsrCycles) / (After.IsrCount - Before.IsrCount), "cyc");
+    Bench_StopAll();
+  }
+
+  /* OS_msDelay round trip: from the call to the first cycle of the next
+     thread (suspend) and from the waking tick to the return (resume) */
+  OSThread_Start(&Bench_Thread[0], BENCH_PRIO_PROBE, &Probe_Main, Bench_Stack[0], sizeof(Bench_Stack[0]));
+
+  OS_msDelay(1U);
+
+  for (Round = 0U, Suspend = 0U, Resume = 0U; Round < BENCH_ROUNDS; ++Round)
+  {
+    Bench_ProbeStarted = false;
+
+    Start    = DWT_CYCCNT;
+    OS_msDelay(1U);
+    Resume  += Bench_Elapsed(Bench_ProbeLast);
+    Suspend += Bench_ProbeFirst - Start;
+  }
+
+  Bench_Report("msdelay_suspend",   Suspend / BENCH_ROUNDS, "cyc");
+  Bench_Report("msdelay_resume",    Resume  / BENCH_ROUNDS, "cyc");
+  Bench_Report("msdelay_roundtrip", (Suspend + Resume) / BENCH_ROUNDS, "cyc");
+  Bench_StopAll();
+
+  Semihost_Exit(SEMIHOST_EXIT_SUCCESS);
+}
+
+
+/*--------------------------------------------------------------
+- @brief OS_OnStackOverflow
+-
+- @desc Fails the run instead of halting silently.
+---------------------------------------------------------------*/
+void OS_OnStackOverflow(OSThread *Thread)
+{
+  (void) Thread;
+
+  Semihost_Write0("BENCH_FAIL stack_overflow\n");
+  Semihost_Exit(SEMIHOST_EXIT_FAILURE);
+}
+
+
+/*--------------------------------------------------------------
+- @brief HardFault_Handler
+-
+- @desc Fails the run instead of halting silently.
+---------------------------------------------------------------*/
+void HardFault_Handler(void)
+{
+  Semihost_Write0("BENCH_FAIL hard_fault\n");
+  Semihost_Exit(SEMIHOST_EXIT_FAILURE);
+}
+
+
+/*--------------------------------------------------------------
+- Main
+---------------------------------------------------------------*/
+int main(void)
+{
+  SystemInit();
+  SysTick_Init();
+  Dwt_Init();
+
+  OS_Init(IdleThread_Stack, sizeof(IdleThread_Stack));
+
+  OSThread_Start(&Control_Thread,
+                 BENCH_PRIO_CONTROL,
+                 &Control_Main,
+                 Control_Stack,
+                 sizeof(Control_Stack));
+
+  OS_Run();
+
+  return 0;
+}
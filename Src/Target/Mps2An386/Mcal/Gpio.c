@@ -0,0 +1,34 @@
+#include "Gpio.h"
+#include "OS/Os.h"
+
+
+/*----------------------------------------------------------------------------
+- @brief GPIO emulation
+-
+- @desc The emulated board has no pins wired: the LED and the debug pins used to scope
+        the scheduler on the target do nothing.
+-----------------------------------------------------------------------------*/
+void GPIO_Init(void) { }
+
+void Led_On  (void) { }
+void Led_Off (void) { }
+void PC2_On  (void) { }
+void PC2_Off (void) { }
+void PC3_On  (void) { }
+void PC3_Off (void) { }
+void PC10_On (void) { }
+void PC10_Off(void) { }
+
+
+/*----------------------------------------------------------------------------
+- @brief Led_Blinky
+-
+- @desc Keeps the timing of the target version (20 ms delay).
+-
+- @param void
+- @return void
+-----------------------------------------------------------------------------*/
+void Led_Blinky(void)
+{
+  OS_msDelay(20U);
+}
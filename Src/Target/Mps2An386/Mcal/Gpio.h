@@ -0,0 +1,18 @@
+#ifndef GPIO_2026_10_17_H
+  #define GPIO_2026_10_17_H
+
+  #include <Mcal/Mcu.h>
+
+  /* Debug pins of the target: no-ops on the emulated board */
+  void Led_On    (void);
+  void Led_Off   (void);
+  void PC2_On    (void);
+  void PC2_Off   (void);
+  void PC3_On    (void);
+  void PC3_Off   (void);
+  void PC10_On   (void);
+  void PC10_Off  (void);
+  void Led_Blinky(void);
+  void GPIO_Init (void);
+
+#endif /* GPIO_2026_10_17_H */
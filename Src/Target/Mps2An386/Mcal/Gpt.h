@@ -0,0 +1,14 @@
+#ifndef GPT_2026_10_17_H
+  #define GPT_2026_10_17_H
+
+  #include <OS/OsCfg.h>
+  #include <Target/Common/Mcal/GptTick.h>
+
+  /* The CMSDK timers only count down from a reload value (and TIMER0 emulates
+     the cycle counter): no free-running 32-bit microsecond counter, so this
+     target has no Gpt.c of its own */
+  #if (OS_CFG_HR_TIME == 1)
+    #error "OS_CFG_HR_TIME is not supported on the MPS2 target"
+  #endif
+
+#endif /* GPT_2026_10_17_H */
@@ -0,0 +1,288 @@
+#include <stdbool.h>
+
+#include <Mcal/Gpt.h>
+#include <Mcal/Mcu.h>
+#include <Mcal/Gpio.h>
+
+/*----------------------------------------------------------------------------
+- @brief SystemInit
+-
+- @desc Initializes system settings: enables the FPU. The emulated board
+        has no clock tree to set up.
+-
+- @param void
+- @return void
+-----------------------------------------------------------------------------*/
+void SystemInit(void)
+{
+  /* set coprocessor access control register CP10 and CP11 Full Access */
+  SCB_CPACR |= (uint32_t)((uint32_t)(3UL << 20U) | (uint32_t)(3UL << 22U));
+}
+
+/*----------------------------------------------------------------------------
+- @brief SetSysClock
+-
+- @desc The MPS2 core clock is fixed at 25 MHz: nothing to configure.
+-
+- @param void
+- @return void
+-----------------------------------------------------------------------------*/
+void SetSysClock(void)
+{
+}
+
+/*----------------------------------------------------------------------------
+- @brief SysTick_Init
+-
+- @desc Initializes the SysTick timer to generate interrupts every 1 ms
+-       using the main processor clock.
+-
+- @param void
+- @return void
+-----------------------------------------------------------------------------*/
+void SysTick_Init(void)
+{
+  /* Reset the SysTick control register. */
+  STK_CTRL = (uint32_t)0x00000000UL;
+
+  /* Set the SysTick reload register to be equivalent to 1ms. */
+  STK_LOAD = (uint32_t)(STK_RELOAD_1MS);   /* 1000us(ms) */
+
+  /* Initialize the SysTick counter value (clear it to zero). */
+  STK_VAL = (uint32_t)0x00000000UL;
+
+  /* Set the SysTicl clock source to be the main processor clock. */
+  STK_CTRL = (uint32_t)0x00000004UL;
+
+  /* Enable the SysTick interrupt. */
+  STK_CTRL |= (uint32_t)(2UL);
+
+  /* Enable the SysTick counter. */
+  STK_CTRL |= (uint32_t)(1UL << 0U);
+}
+
+
+/*----------------------------------------------------------------------------
+- File-Local Variables (tickless idle)
+-----------------------------------------------------------------------------*/
+static uint32_t SysTick_OneShotTicks;
+static uint32_t SysTick_OneShotLoad;
+
+
+/*----------------------------------------------------------------------------
+- @brief SysTick_StartOneShot
+-
+- @desc Reprograms the SysTick for a single long period that ends exactly
+-       on the tick boundary Ticks milliseconds ahead. The fraction of the
+-       current tick already counted is preserved. Must be called with
+-       interrupts DISABLED.
+-
+- @param Ticks   Number of ticks to suppress (clamped to STK_MAX_IDLE_TICKS)
+- @return bool   false if a tick is already pending (nothing reprogrammed)
+-----------------------------------------------------------------------------*/
+bool SysTick_StartOneShot(uint32_t Ticks)
+{
+  if(Ticks > STK_MAX_IDLE_TICKS)
+  {
+    Ticks = STK_MAX_IDLE_TICKS;
+  }
+
+  /* Stop the counter while it is being reprogrammed */
+  STK_CTRL &= (uint32_t)(~STK_CTRL_ENABLE);
+
+  if((ICSR & ICSR_PENDSTSET) != 0U)
+  {
+    /* A tick is already pending: keep the periodic mode */
+    STK_CTRL |= STK_CTRL_ENABLE;
+
+    return false;
+  }
+
+  SysTick_OneShotTicks = Ticks;
+  SysTick_OneShotLoad  = STK_VAL + ((Ticks - 1U) * STK_RELOAD_1MS);
+
+  /* Restart from the new reload value */
+  STK_LOAD  = SysTick_OneShotLoad;
+  STK_VAL   = 0U;
+  STK_CTRL |= STK_CTRL_ENABLE;
+
+  return true;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief SysTick_StopOneShot
+-
+- @desc Stops a one-shot period started by SysTick_StartOneShot, returns the
+-       number of complete ticks that elapsed in the meantime and resumes
+-       the periodic 1 ms tick aligned to the original tick boundaries.
+-       If the one-shot expired, the final tick is left pending for
+-       SysTick_Handler. Must be called with interrupts DISABLED.
+-
+- @param void
+- @return uint32_t  Number of complete ticks not seen by SysTick_Handler
+-----------------------------------------------------------------------------*/
+uint32_t SysTick_StopOneShot(void)
+{
+  uint32_t Elapsed;
+  uint32_t NextLoad;
+
+  /* Stop the counter (reading STK_CTRL also clears COUNTFLAG) */
+  const uint32_t Ctrl = STK_CTRL;
+
+  STK_CTRL = Ctrl & (uint32_t)(~STK_CTRL_ENABLE);
+
+  if(((Ctrl & STK_CTRL_COUNTFLAG) != 0U) || ((ICSR & ICSR_PENDSTSET) != 0U))
+  {
+    /* Expired: the last tick is pending and handled by SysTick_Handler */
+    const uint32_t Spent = SysTick_OneShotLoad - STK_VAL;
+
+    Elapsed  = SysTick_OneShotTicks - 1U;
+    NextLoad = (Spent < STK_RELOAD_1MS) ? (STK_RELOAD_1MS - Spent) : 1U;
+  }
+  else
+  {
+    /* Woken early by another interrupt */
+    const uint32_t Remaining = STK_VAL;
+
+    Elapsed  = (SysTick_OneShotTicks - 1U) - (Remaining / STK_RELOAD_1MS);
+    NextLoad = Remaining % STK_RELOAD_1MS;
+
+    if(NextLoad == 0U)
+    {
+      NextLoad = STK_RELOAD_1MS;
+    }
+  }
+
+  /* Finish the current tick, then fall back to the 1 ms period */
+  STK_LOAD  = NextLoad;
+  STK_VAL   = 0U;
+  STK_CTRL |= STK_CTRL_ENABLE;
+  STK_LOAD  = STK_RELOAD_1MS;
+
+  return Elapsed;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief Dwt_Init
+-
+- @desc Starts the cycle counter used for cycle-count measurements. QEMU
+-       does not implement the DWT, so CMSDK APB timer 0 runs free from
+-       0xFFFFFFFF at the core clock instead (see DWT_CYCCNT). The
+-       startup code already starts it at reset; a running timer is left
+-       alone, so that the boot time keeps counting from there.
+-
+- @param void
+- @return void
+-----------------------------------------------------------------------------*/
+void Dwt_Init(void)
+{
+  /* Load the full range and start without interrupt, unless it runs */
+  if ((TIMER0_CTRL & (uint32_t)(1UL << 0U)) == 0UL)
+  {
+    TIMER0_RELOAD = (uint32_t)0xFFFFFFFFUL;
+    TIMER0_VALUE  = (uint32_t)0xFFFFFFFFUL;
+    TIMER0_CTRL   = (uint32_t)(1UL << 0U);
+  }
+}
+
+/*----------------------------------------------------------------------------
+- @brief NVIC_SetPriority
+-
+- @desc Sets the priority of a given IRQ or system exception.
+-       Supports both system exceptions (negative IRQn) and peripheral IRQs.
+-
+- @param IRQn     : IRQ number (negative for system exceptions)
+- @param Priority : Priority value (0..15, lower = higher priority)
+- @return void
+-----------------------------------------------------------------------------*/
+void NVIC_SetPriority(int32_t IRQn, uint32_t Priority)
+{
+  /* Shift for top 4 bits */
+  uint8_t Prio_Val = (Priority & 0xFU) << 4U;
+
+  if(IRQn < (int32_t)0U)
+  {
+    /* System Exceptions: map IRQn to SHP registers */
+    uint32_t RegAddr           = 0xE000ED18UL + (((IRQn & (int32_t)0xFU) - 4U) * 1U); // 1 byte per priority field
+    volatile uint8_t *Prio_Ptr = (volatile uint8_t *)RegAddr;
+    *Prio_Ptr                  = Prio_Val;
+  }
+  else
+  {
+    /* Peripheral IRQs */
+    volatile uint8_t *Prio_Ptr = (volatile uint8_t *)(NVIC_IPR_BASE + (uint32_t)IRQn);
+    *Prio_Ptr                  = Prio_Val;
+  }
+}
+
+/*----------------------------------------------------------------------------
+- @brief Wait_For_Interrupt
+-
+- @desc Executes the WFI (Wait For Interrupt) instruction to put the CPU
+-       into low-power sleep mode until an interrupt occurs.
+-----------------------------------------------------------------------------*/
+inline void Wait_For_Interrupt(void)
+{
+  __asm volatile ("wfi":::"memory");
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief Enable_Irq
+-
+- @desc Enables all maskable interrupts by setting the I-bit in the CPSR.
+-----------------------------------------------------------------------------*/
+inline void Enable_Irq(void)
+{
+  __asm volatile ("cpsie i" ::: "memory");
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief Disable_Irq
+-
+- @desc Disables all maskable interrupts by clearing the I-bit in the CPSR.
+-----------------------------------------------------------------------------*/
+inline void Disable_Irq(void)
+{
+  __asm volatile ("cpsid i" ::: "memory");
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief Mask_Irq
+-
+- @desc Raises BASEPRI so that the interrupts of the given priority and
+-       below are masked, more urgent ones keep running. BASEPRI_MAX never
+-       lowers the mask, so the call nests.
+-
+- @param Priority : Priority value (1..15) of the most urgent masked interrupt
+- @return uint32_t : Previous mask, for Restore_Irq
+-----------------------------------------------------------------------------*/
+inline uint32_t Mask_Irq(uint32_t Priority)
+{
+  uint32_t Mask;
+
+  __asm volatile ("mrs %0, basepri" : "=r" (Mask) :: "memory");
+  __asm volatile ("msr basepri_max, %0" :: "r" ((Priority & 0xFU) << 4U) : "memory");
+
+  return Mask;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief Restore_Irq
+-
+- @desc Restores the BASEPRI value returned by the matching Mask_Irq.
+-
+- @param Mask : Previous mask
+- @return void
+-----------------------------------------------------------------------------*/
+inline void Restore_Irq(uint32_t Mask)
+{
+  __asm volatile ("msr basepri, %0" :: "r" (Mask) : "memory");
+}
+
+
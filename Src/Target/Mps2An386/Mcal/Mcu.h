@@ -0,0 +1,103 @@
+#ifndef MCU_2026_10_17_H
+  #define MCU_2026_10_17_H
+
+  #include <stdbool.h>
+  #include <stdint.h>
+
+  /*----------------------------------------------------------------------------
+  - Arm MPS2 board with the AN386 (Cortex-M4) image, as emulated by
+  - qemu-system-arm -M mps2-an386
+  -
+  - Core and SysTick are those of the STM32F446re, the clock is fixed at
+  - 25 MHz. QEMU has no DWT: the cycle counter is the CMSDK APB timer 0
+  - counting down from 0xFFFFFFFF at the core clock.
+  -----------------------------------------------------------------------------*/
+  typedef enum
+  {
+    /******  Cortex-M4 Processor Exceptions Numbers ****************************************************************/
+    NonMaskableInt_IRQn         = -14,    /*   2 Non Maskable Interrupt                                            */
+    MemoryManagement_IRQn       = -12,    /*   4 Cortex-M4 Memory Management Interrupt                             */
+    BusFault_IRQn               = -11,    /*   5 Cortex-M4 Bus Fault Interrupt                                     */
+    UsageFault_IRQn             = -10,    /*   6 Cortex-M4 Usage Fault Interrupt                                   */
+    SVCall_IRQn                 = -5,     /*   11 Cortex-M4 SV Call Interrupt                                      */
+    DebugMonitor_IRQn           = -4,     /*   12 Cortex-M4 Debug Monitor Interrupt                                */
+    PendSV_IRQn                 = -2,     /*   14 Cortex-M4 Pend SV Interrupt                                      */
+    SysTick_IRQn                = -1,     /*   15 Cortex-M4 System Tick Interrupt                                  */
+    /******  MPS2 AN386 specific Interrupt Numbers *****************************************************************/
+    UART0_IRQn                  = 0,      /*   UART 0 RX and TX Combined Interrupt                                 */
+    TIMER0_IRQn                 = 8,      /*   CMSDK APB Timer 0 Interrupt                                         */
+    TIMER1_IRQn                 = 9       /*   CMSDK APB Timer 1 Interrupt                                         */
+  }IRQn_Type;
+
+  /* Code and data share the zero-wait-state SSRAM: nothing to relocate */
+  #define MCU_RAMFUNC
+
+  /* Single SSRAM region: stacks, DMA buffers and no-init data are ordinary data */
+  #define MCU_THREAD_STACK       __attribute__((aligned(8)))
+  #define MCU_DMA_BUFFER
+  #define MCU_NOINIT
+
+
+  /* Base addresses for peripheral registers */
+  #define SCB_BASE              0xE000ED00UL
+  #define STK_BASE              0xE000E010UL
+  #define NVIC_ISER_BASE        0xE000E100UL
+  #define NVIC_IPR_BASE         0xE000E400UL
+  #define ICSR_BASE             0xE000ED04UL
+  #define TIMER0_BASE           0x40000000UL
+
+  /* System Handler Priority Registers (SHP) */
+  #define NVIC_SYS_PRI1_R      (*(volatile uint32_t*)(SCB_BASE + 0x18UL)) // SHP[0]
+  #define NVIC_SYS_PRI2_R      (*(volatile uint32_t*)(SCB_BASE + 0x1CUL)) // SHP[1]
+  #define NVIC_SYS_PRI3_R      (*(volatile uint32_t*)(SCB_BASE + 0x20UL)) // SHP[2]
+
+  /* Interrupt control and state register */
+  #define ICSR                 (*(volatile uint32_t*)(ICSR_BASE + 0x00UL))
+  #define ICSR_PENDSTSET       (1UL << 26U)
+  #define ICSR_PENDSVSET       (1UL << 28U)
+
+  /* NVIC registers */
+  #define NVIC_ISER0           (*(volatile uint32_t*)(NVIC_ISER_BASE + 0x00UL))
+
+  /* SCB registers */
+  #define SCB_CPACR            (*(volatile uint32_t*)(SCB_BASE + 0x88UL))
+  #define SCB_SCR              (*(volatile uint32_t*)(SCB_BASE + 0x10UL))
+  #define SCB_FPCCR            (*(volatile uint32_t*)(SCB_BASE + 0x234UL))
+
+  /* SysTick registers */
+  #define STK_CTRL             (*(volatile uint32_t*)(STK_BASE + 0x00UL))
+  #define STK_LOAD             (*(volatile uint32_t*)(STK_BASE + 0x04UL))
+  #define STK_VAL              (*(volatile uint32_t*)(STK_BASE + 0x08UL))
+
+  /* SysTick control bits and 1 ms reload value (25 MHz core clock) */
+  #define STK_CTRL_ENABLE      (1UL << 0U)
+  #define STK_CTRL_COUNTFLAG   (1UL << 16U)
+  #define STK_RELOAD_1MS       (25000UL)
+  #define STK_MAX_IDLE_TICKS   (0x00FFFFFFUL / STK_RELOAD_1MS)
+
+  /* CMSDK APB timer 0 registers */
+  #define TIMER0_CTRL          (*(volatile uint32_t*)(TIMER0_BASE + 0x00UL))
+  #define TIMER0_VALUE         (*(volatile uint32_t*)(TIMER0_BASE + 0x04UL))
+  #define TIMER0_RELOAD        (*(volatile uint32_t*)(TIMER0_BASE + 0x08UL))
+
+  /* Cycle counter: timer 0 counts down, the difference of two reads is
+     the number of core clock cycles in between */
+  #define DWT_CYCCNT           ((uint32_t)(0xFFFFFFFFUL - TIMER0_VALUE))
+
+  /* Functions prototypes */
+  void SystemInit        (void);
+  void SetSysClock       (void);
+  void SysTick_Init      (void);
+  void Dwt_Init          (void);
+  void Enable_Irq        (void);
+  void Disable_Irq       (void);
+  uint32_t Mask_Irq      (uint32_t Priority);
+  void Restore_Irq       (uint32_t Mask);
+  void Wait_For_Interrupt(void);
+
+  void NVIC_SetPriority(int32_t IRQn, uint32_t priority);
+
+  bool     SysTick_StartOneShot(uint32_t Ticks);
+  uint32_t SysTick_StopOneShot (void);
+
+#endif // MCU_2026_10_17_H
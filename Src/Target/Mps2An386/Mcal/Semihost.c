@@ -0,0 +1,63 @@
+#include <stdint.h>
+#include "Semihost.h"
+
+/* Semihosting operation numbers */
+#define SEMIHOST_SYS_WRITE0     (0x04UL)
+#define SEMIHOST_SYS_EXIT       (0x18UL)
+
+
+/*----------------------------------------------------------------------------
+- @brief Semihost_Call
+
+- @desc Traps into the debugger/emulator with operation Op and argument Arg.
+
+- @param Op    Semihosting operation number
+         Arg   Argument (value or pointer, depending on Op)
+
+- @return uint32_t  Result of the operation
+-----------------------------------------------------------------------------*/
+static uint32_t Semihost_Call(uint32_t Op, uint32_t Arg)
+{
+  register uint32_t r0 __asm("r0") = Op;
+  register uint32_t r1 __asm("r1") = Arg;
+
+  __asm volatile ("bkpt 0xAB" : "+r" (r0) : "r" (r1) : "memory");
+
+  return r0;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief Semihost_Write0
+
+- @desc Writes a zero-terminated string to the host console (SYS_WRITE0).
+
+- @param Str   String to write
+
+- @return void
+-----------------------------------------------------------------------------*/
+void Semihost_Write0(const char *Str)
+{
+  (void) Semihost_Call(SEMIHOST_SYS_WRITE0, (uint32_t)Str);
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief Semihost_Exit
+
+- @desc Reports the end of the application to the host (SYS_EXIT). On a
+        32-bit target the reason code is passed directly.
+
+- @param Reason   SEMIHOST_EXIT_SUCCESS or SEMIHOST_EXIT_FAILURE
+
+- @return void (does not return)
+-----------------------------------------------------------------------------*/
+void Semihost_Exit(uint32_t Reason)
+{
+  (void) Semihost_Call(SEMIHOST_SYS_EXIT, Reason);
+
+  for(;;)
+  {
+    ;
+  }
+}
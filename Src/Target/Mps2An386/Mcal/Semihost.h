@@ -0,0 +1,21 @@
+#ifndef SEMIHOST_2026_10_17_H
+  #define SEMIHOST_2026_10_17_H
+
+  #include <stdint.h>
+
+  /*----------------------------------------------------------------------------
+  - Arm semihosting (BKPT 0xAB): console output and exit of the emulator.
+  - QEMU must be started with -semihosting-config enable=on,target=native.
+  -----------------------------------------------------------------------------*/
+
+  /* Exit status passed to Semihost_Exit */
+  #define SEMIHOST_EXIT_SUCCESS    (0x20026UL)    /* ADP_Stopped_ApplicationExit */
+  #define SEMIHOST_EXIT_FAILURE    (0x20023UL)    /* ADP_Stopped_RunTimeErrorUnknown */
+
+  /* Writes a zero-terminated string to the host console */
+  void Semihost_Write0(const char *Str);
+
+  /* Stops the emulator (QEMU exits with 0 for SEMIHOST_EXIT_SUCCESS, 1 otherwise) */
+  void Semihost_Exit(uint32_t Reason) __attribute__((noreturn));
+
+#endif /* SEMIHOST_2026_10_17_H */
@@ -10,20 +10,100 @@
   #define USER_BUTTON          13UL
   #define WAKEUP_PIN            3UL
 
-  void Led_On    (void);
-  void Led_Off   (void);
-  void PC2_On    (void);
-  void PC2_Off   (void);
-  void PC3_On    (void);
-  void PC3_Off   (void);
-  void PC10_On   (void);
-  void PC10_Off  (void);
+  /* Output and bit set/reset registers of a port, from its base address */
+  #define GPIO_ODR(Port)       (*(volatile uint32_t*)((Port) + 0x14UL))
+  #define GPIO_BSRR(Port)      (*(volatile uint32_t*)((Port) + 0x18UL))
+
+  /* Output pin descriptor: port base address and pin mask */
+  typedef struct
+  {
+    uint32_t Port;                    /* GPIOx_BASE */
+    uint32_t Mask;                    /* Pin mask (bits 0 .. 15) */
+  } Gpio_PinType;
+
+  /* Pin descriptor known at compile time, e.g. GPIO_PIN(GPIOC_BASE, 2U) */
+  #define GPIO_PIN(Port, Pin)  ((Gpio_PinType){ (Port), (1UL << (Pin)) })
+
+  #define GPIO_PIN_LED         GPIO_PIN(GPIOA_BASE, USER_LED)
+  #define GPIO_PIN_PC2         GPIO_PIN(GPIOC_BASE, 2U)
+  #define GPIO_PIN_PC3         GPIO_PIN(GPIOC_BASE, 3U)
+  #define GPIO_PIN_PC10        GPIO_PIN(GPIOC_BASE, 10U)
+
   void Led_Blinky(void);
   void GPIO_Init (void);
 
-#endif /* GPIO_2025_06_10_H */
 
+  /*----------------------------------------------------------------------------
+  - @brief Gpio_SetPin / Gpio_ResetPin
+  -
+  - @desc Drives an output pin high or low with a single store to BSRR.
+    The store only affects the pins of its set bits, so it needs no lock
+    against threads or interrupts writing other pins of the port.
+  -
+  - @param Pin   Pin descriptor
+  - @return void
+  -----------------------------------------------------------------------------*/
+  MCU_INLINE void Gpio_SetPin(const Gpio_PinType Pin)
+  {
+    GPIO_BSRR(Pin.Port) = Pin.Mask;
+  }
+
+  MCU_INLINE void Gpio_ResetPin(const Gpio_PinType Pin)
+  {
+    GPIO_BSRR(Pin.Port) = Pin.Mask << 16U;
+  }
 
 
+  /*----------------------------------------------------------------------------
+  - @brief Gpio_TogglePin
+  -
+  - @desc Inverts an output pin: reads ODR, then sets or resets the pin
+    through BSRR. The other pins of the port are never written; only a
+    concurrent writer of the same pin can race with it.
+  -
+  - @param Pin   Pin descriptor
+  - @return void
+  -----------------------------------------------------------------------------*/
+  MCU_INLINE void Gpio_TogglePin(const Gpio_PinType Pin)
+  {
+    GPIO_BSRR(Pin.Port) = ((GPIO_ODR(Pin.Port) & Pin.Mask) != 0UL) ? (Pin.Mask << 16U) : Pin.Mask;
+  }
 
 
+  /*----------------------------------------------------------------------------
+  - @brief Gpio_WritePort
+  -
+  - @desc Sets and resets several pins of one port in a single store, so
+    they change at the same time. A pin in both masks is set.
+  -
+  - @param Port       GPIOx_BASE
+  - @param SetMask    Pins to drive high (bits 0 .. 15)
+  - @param ResetMask  Pins to drive low (bits 0 .. 15)
+  - @return void
+  -----------------------------------------------------------------------------*/
+  MCU_INLINE void Gpio_WritePort(const uint32_t Port, const uint32_t SetMask, const uint32_t ResetMask)
+  {
+    GPIO_BSRR(Port) = (SetMask & 0xFFFFUL) | ((ResetMask & 0xFFFFUL) << 16U);
+  }
+
+
+
+  /*----------------------------------------------------------------------------
+  - @brief Led_On / Led_Off / PCx_On / PCx_Off
+  -
+  - @desc Board pins of the example and the scheduler debug pins (PC2:
+    SysTick, PC3: thread, PC10: idle), driven through their descriptors.
+  -
+  - @param void
+  - @return void
+  -----------------------------------------------------------------------------*/
+  MCU_INLINE void Led_On  (void) { Gpio_SetPin  (GPIO_PIN_LED);  }
+  MCU_INLINE void Led_Off (void) { Gpio_ResetPin(GPIO_PIN_LED);  }
+  MCU_INLINE void PC2_On  (void) { Gpio_SetPin  (GPIO_PIN_PC2);  }
+  MCU_INLINE void PC2_Off (void) { Gpio_ResetPin(GPIO_PIN_PC2);  }
+  MCU_INLINE void PC3_On  (void) { Gpio_SetPin  (GPIO_PIN_PC3);  }
+  MCU_INLINE void PC3_Off (void) { Gpio_ResetPin(GPIO_PIN_PC3);  }
+  MCU_INLINE void PC10_On (void) { Gpio_SetPin  (GPIO_PIN_PC10); }
+  MCU_INLINE void PC10_Off(void) { Gpio_ResetPin(GPIO_PIN_PC10); }
+
+#endif /* GPIO_2025_06_10_H */
@@ -1,57 +1,131 @@
-#include <Mcal/Gpio.h>
 #include <Mcal/Gpt.h>
 #include <Mcal/Mcu.h>
 #include <OS/Os.h>
+#include <OS/OsTrace.h>
 
 /*----------------------------------------------------------------------------
-- File-Local Variables
+- TIM2 microsecond time base (OS_CFG_HR_TIME); the millisecond counter and
+- SysTick_Handler are in Target/Common/Mcal/GptTick.c
 -----------------------------------------------------------------------------*/
-static Gpt_ValueType millisec_counter;
-
 
+#if (OS_CFG_HR_TIME == 1)
 /*----------------------------------------------------------------------------
 - Function Declarations
 -----------------------------------------------------------------------------*/
-void SysTick_Handler(void);
+void TIM2_IRQHandler(void);
 
 
 /*----------------------------------------------------------------------------
-- @brief Gpt_GetTimeElapsed
+- @brief Gpt_HrInit
 -
-- @desc Returns the elapsed time in milliseconds from the system counter.
+- @desc Starts TIM2 as a free-running 32-bit up-counter at 1 MHz (90 MHz
+  APB1 timer clock / 90). Compare channel 1 serves as the alarm, its
+  interrupt runs at the kernel ceiling (OS_CFG_KERNEL_IRQ_PRIO).
 -
-- @param DummyChannelIndex   Unused channel index parameter
-- @return Gpt_ValueType      Elapsed time in milliseconds
+- @param void
+- @return void
 -----------------------------------------------------------------------------*/
-Gpt_ValueType Gpt_GetTimeElapsed(const Gpt_ChannelType DummyChannelIndex)
+void Gpt_HrInit(void)
 {
-  (void) DummyChannelIndex;
+  RCC_APB1ENR |= RCC_APB1ENR_TIM2EN;
+
+  TIM2_CR1  = 0UL;
+  TIM2_DIER = 0UL;
+  TIM2_PSC  = TIM2_PSC_1MHZ;
+  TIM2_ARR  = 0xFFFFFFFFUL;
+  TIM2_CNT  = 0UL;
+
+  /* Load the prescaler, then drop the update flag it raises */
+  TIM2_EGR  = TIM_EGR_UG;
+  TIM2_SR   = 0UL;
 
-  return millisec_counter;
+  NVIC_SetPriority(TIM2_IRQn, (uint32_t)OS_CFG_KERNEL_IRQ_PRIO);
+  NVIC_ISER0 = (uint32_t)(1UL << (uint32_t)TIM2_IRQn);
+
+  TIM2_CR1  = TIM_CR1_CEN;
 }
 
 
 /*----------------------------------------------------------------------------
-- @brief SysTick_Handler
+- @brief Gpt_HrGetTime
 -
-- @desc SysTick interrupt service routine: increments millisecond counter,
-  updates delayed threads, runs scheduler, and toggles PC2 for timing.
+- @desc Returns the microsecond counter (TIM2_CNT, wraps around after
+  2^32 us, about 71 minutes).
 -
 - @param void
+- @return uint32_t  Time in microseconds
+-----------------------------------------------------------------------------*/
+MCU_RAMFUNC uint32_t Gpt_HrGetTime(void)
+{
+  return TIM2_CNT;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief Gpt_HrStartAlarm
+-
+- @desc Arms the compare interrupt for an absolute microsecond time. If the
+  counter has already reached it while arming, the compare event is
+  generated by software so that the interrupt is not lost for a whole
+  counter period.
+  Must be called in a critical section.
+-
+- @param Time   Microsecond time of the interrupt
 - @return void
 -----------------------------------------------------------------------------*/
-void SysTick_Handler(void)
+MCU_RAMFUNC void Gpt_HrStartAlarm(const uint32_t Time)
 {
-  PC2_On();
+  TIM2_CCR1  = Time;
+  TIM2_SR    = ~TIM_SR_CC1IF;
+  TIM2_DIER |= TIM_DIER_CC1IE;
 
-  ++millisec_counter;
+  if ((int32_t)(Time - TIM2_CNT) <= 0)
+  {
+    TIM2_EGR = TIM_EGR_CC1G;
+  }
+}
 
-  OS_Tick();
 
-  Disable_Irq();
+/*----------------------------------------------------------------------------
+- @brief Gpt_HrStopAlarm
+-
+- @desc Disarms the compare interrupt.
+  Must be called in a critical section.
+-
+- @param void
+- @return void
+-----------------------------------------------------------------------------*/
+MCU_RAMFUNC void Gpt_HrStopAlarm(void)
+{
+  TIM2_DIER &= ~TIM_DIER_CC1IE;
+  TIM2_SR    = ~TIM_SR_CC1IF;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief TIM2_IRQHandler
+-
+- @desc TIM2 compare interrupt: wakes the threads whose microsecond delay
+  has expired and runs the scheduler. The flag is cleared first, so the
+  write has reached the timer before the handler returns.
+-
+- @param void
+- @return void
+-----------------------------------------------------------------------------*/
+MCU_RAMFUNC void TIM2_IRQHandler(void)
+{
+  OSCritical Crit;
+
+  OS_TRACE_ISR_IN(TIM2_IRQn);
+
+  TIM2_SR = ~TIM_SR_CC1IF;
+
+  OS_HrAlarm();
+
+  OS_CRITICAL_ENTER(Crit);
   OS_Sched();
-  Enable_Irq();
+  OS_CRITICAL_EXIT(Crit);
 
-  PC2_Off();
+  OS_TRACE_ISR_OUT(TIM2_IRQn);
 }
-
+#endif
@@ -4,12 +4,22 @@
 #include <Mcal/Mcu.h>
 #include <Mcal/Gpio.h>
 
+#if (MCU_CFG_VTOR_RAM == 1)
+/*----------------------------------------------------------------------------
+- Linker Symbols (vector table in RAM)
+-----------------------------------------------------------------------------*/
+extern const uint32_t _rom_vector_begin;  /* Vector table in flash (.isr_vector)   */
+extern uint32_t       _ram_vector_begin;  /* Start of its RAM copy (.ram_vector)   */
+extern uint32_t       _ram_vector_end;    /* End of its RAM copy                   */
+#endif
+
 /*----------------------------------------------------------------------------
 - @brief SystemInit
 -
 - @desc Initializes system settings: enables FPU, configures
         internal clock, resets RCC registers, disables interrupts, and sets
-        Flash latency and caches.
+        Flash latency and caches. With MCU_CFG_VTOR_RAM, moves the vector
+        table to RAM.
 -
 - @param void
 - @return void
@@ -36,6 +46,23 @@ void SystemInit(void)
 
   /* Configure Flash prefetch, Instruction cache, Data cache and wait state (5 wait states) */
   FLASH_ACR = (uint32_t)((1UL << 9U) | (1UL << 10U) | (5UL << 0U));
+
+#if (MCU_CFG_VTOR_RAM == 1)
+  /* Take the exceptions from the RAM copy of the vector table */
+  {
+    const uint32_t *Src = &_rom_vector_begin;
+    uint32_t       *Dst;
+
+    for (Dst = &_ram_vector_begin; Dst < &_ram_vector_end; ++Dst)
+    {
+      *Dst = *Src++;
+    }
+  }
+
+  SCB_VTOR = (uint32_t)(uintptr_t)&_ram_vector_begin;
+
+  __asm volatile ("dsb\n isb" ::: "memory");
+#endif
 }
 
 /*----------------------------------------------------------------------------
@@ -107,7 +134,7 @@ void SysTick_Init(void)
   STK_CTRL = (uint32_t)0x00000000UL;
 
   /* Set the SysTick reload register to be equivalent to 1ms. */
-  STK_LOAD = (uint32_t)(180000UL);   /* 1000us(ms) */
+  STK_LOAD = (uint32_t)(STK_RELOAD_1MS);   /* 1000us(ms) */
   //STK_LOAD = (uint32_t)(180UL);    /*   1us      here I saw a strange behvior, sytick interrupt too fast it does not let osthread start to happen*/
   //STK_LOAD = (uint32_t)(18000UL);  /*   100us      */
 
@@ -125,6 +152,131 @@ void SysTick_Init(void)
 }
 
 
+/*----------------------------------------------------------------------------
+- File-Local Variables (tickless idle)
+-----------------------------------------------------------------------------*/
+static uint32_t SysTick_OneShotTicks;
+static uint32_t SysTick_OneShotLoad;
+
+
+/*----------------------------------------------------------------------------
+- @brief SysTick_StartOneShot
+-
+- @desc Reprograms the SysTick for a single long period that ends exactly
+-       on the tick boundary Ticks milliseconds ahead. The fraction of the
+-       current tick already counted is preserved. Must be called with
+-       interrupts DISABLED.
+-
+- @param Ticks   Number of ticks to suppress (clamped to STK_MAX_IDLE_TICKS)
+- @return bool   false if a tick is already pending (nothing reprogrammed)
+-----------------------------------------------------------------------------*/
+bool SysTick_StartOneShot(uint32_t Ticks)
+{
+  if(Ticks > STK_MAX_IDLE_TICKS)
+  {
+    Ticks = STK_MAX_IDLE_TICKS;
+  }
+
+  /* Stop the counter while it is being reprogrammed */
+  STK_CTRL &= (uint32_t)(~STK_CTRL_ENABLE);
+
+  if((ICSR & ICSR_PENDSTSET) != 0U)
+  {
+    /* A tick is already pending: keep the periodic mode */
+    STK_CTRL |= STK_CTRL_ENABLE;
+
+    return false;
+  }
+
+  SysTick_OneShotTicks = Ticks;
+  SysTick_OneShotLoad  = STK_VAL + ((Ticks - 1U) * STK_RELOAD_1MS);
+
+  /* Restart from the new reload value */
+  STK_LOAD  = SysTick_OneShotLoad;
+  STK_VAL   = 0U;
+  STK_CTRL |= STK_CTRL_ENABLE;
+
+  return true;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief SysTick_StopOneShot
+-
+- @desc Stops a one-shot period started by SysTick_StartOneShot, returns the
+-       number of complete ticks that elapsed in the meantime and resumes
+-       the periodic 1 ms tick aligned to the original tick boundaries.
+-       If the one-shot expired, the final tick is left pending for
+-       SysTick_Handler. Must be called with interrupts DISABLED.
+-
+- @param void
+- @return uint32_t  Number of complete ticks not seen by SysTick_Handler
+-----------------------------------------------------------------------------*/
+uint32_t SysTick_StopOneShot(void)
+{
+  uint32_t Elapsed;
+  uint32_t NextLoad;
+
+  /* Stop the counter (reading STK_CTRL also clears COUNTFLAG) */
+  const uint32_t Ctrl = STK_CTRL;
+
+  STK_CTRL = Ctrl & (uint32_t)(~STK_CTRL_ENABLE);
+
+  if(((Ctrl & STK_CTRL_COUNTFLAG) != 0U) || ((ICSR & ICSR_PENDSTSET) != 0U))
+  {
+    /* Expired: the last tick is pending and handled by SysTick_Handler */
+    const uint32_t Spent = SysTick_OneShotLoad - STK_VAL;
+
+    Elapsed  = SysTick_OneShotTicks - 1U;
+    NextLoad = (Spent < STK_RELOAD_1MS) ? (STK_RELOAD_1MS - Spent) : 1U;
+  }
+  else
+  {
+    /* Woken early by another interrupt */
+    const uint32_t Remaining = STK_VAL;
+
+    Elapsed  = (SysTick_OneShotTicks - 1U) - (Remaining / STK_RELOAD_1MS);
+    NextLoad = Remaining % STK_RELOAD_1MS;
+
+    if(NextLoad == 0U)
+    {
+      NextLoad = STK_RELOAD_1MS;
+    }
+  }
+
+  /* Finish the current tick, then fall back to the 1 ms period */
+  STK_LOAD  = NextLoad;
+  STK_VAL   = 0U;
+  STK_CTRL |= STK_CTRL_ENABLE;
+  STK_LOAD  = STK_RELOAD_1MS;
+
+  return Elapsed;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief Dwt_Init
+-
+- @desc Enables the DWT cycle counter used for cycle-count measurements.
+-       The startup code already starts it at reset; a running counter
+-       is left alone, so that the boot time keeps counting from there.
+-
+- @param void
+- @return void
+-----------------------------------------------------------------------------*/
+void Dwt_Init(void)
+{
+  /* Enable trace (TRCENA) */
+  SCB_DEMCR |= (uint32_t)(1UL << 24U);
+
+  /* Reset and start the cycle counter (CYCCNTENA) unless it runs */
+  if ((DWT_CTRL & (uint32_t)(1UL << 0U)) == 0UL)
+  {
+    DWT_CYCCNT = (uint32_t)0x00000000UL;
+    DWT_CTRL  |= (uint32_t)(1UL << 0U);
+  }
+}
+
 /*----------------------------------------------------------------------------
 - @brief NVIC_SetPriority
 -
@@ -189,3 +341,38 @@ inline void Disable_Irq(void)
 }
 
 
+/*----------------------------------------------------------------------------
+- @brief Mask_Irq
+-
+- @desc Raises BASEPRI so that the interrupts of the given priority and
+-       below are masked, more urgent ones keep running. BASEPRI_MAX never
+-       lowers the mask, so the call nests.
+-
+- @param Priority : Priority value (1..15) of the most urgent masked interrupt
+- @return uint32_t : Previous mask, for Restore_Irq
+-----------------------------------------------------------------------------*/
+MCU_RAMFUNC uint32_t Mask_Irq(uint32_t Priority)
+{
+  uint32_t Mask;
+
+  __asm volatile ("mrs %0, basepri" : "=r" (Mask) :: "memory");
+  __asm volatile ("msr basepri_max, %0" :: "r" ((Priority & 0xFU) << 4U) : "memory");
+
+  return Mask;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief Restore_Irq
+-
+- @desc Restores the BASEPRI value returned by the matching Mask_Irq.
+-
+- @param Mask : Previous mask
+- @return void
+-----------------------------------------------------------------------------*/
+MCU_RAMFUNC void Restore_Irq(uint32_t Mask)
+{
+  __asm volatile ("msr basepri, %0" :: "r" (Mask) : "memory");
+}
+
+
@@ -1,6 +1,7 @@
 #ifndef MCU_2023_08_19_H
   #define MCU_2023_08_19_H
 
+  #include <stdbool.h>
   #include <stdint.h>
 
   typedef enum
@@ -103,6 +104,44 @@
     FMPI2C1_ER_IRQn             = 96      /*   FMPI2C1 Error Interrupt                                             */
   }IRQn_Type;
 
+  /* RAM functions: 1 = code marked MCU_RAMFUNC (context switch, tick and
+                        scheduler) is linked to .ramfunc and copied to
+                        SRAM by crt_init_ram(), so its timing does not
+                        depend on flash wait states and ART cache hits,
+                    0 = all code runs from flash */
+  #if !defined(MCU_CFG_RAMFUNC)
+    #define MCU_CFG_RAMFUNC      1
+  #endif
+
+  /* Vector table in SRAM: 1 = SystemInit() copies .isr_vector to the
+                              .ram_vector block reserved by the linker
+                              script and points VTOR at it,
+                          0 = the table stays in flash */
+  #if !defined(MCU_CFG_VTOR_RAM)
+    #define MCU_CFG_VTOR_RAM     0
+  #endif
+
+  #if (MCU_CFG_RAMFUNC == 1)
+    #define MCU_RAMFUNC          __attribute__((section(".ramfunc"), noinline))
+  #else
+    #define MCU_RAMFUNC
+  #endif
+
+  /* Small register accessors used by MCU_RAMFUNC code: inlined even at -O0,
+     so they do not stay in flash as out-of-line calls */
+  #define MCU_INLINE             static inline __attribute__((always_inline))
+
+  /* Data placement (see stm32f446re.ld):
+     MCU_THREAD_STACK  thread stacks, .thread_stack in SRAM1, not cleared
+                       at startup, 8-byte aligned as required by AAPCS
+     MCU_DMA_BUFFER    DMA buffers, .dma_buffer in SRAM2 (separate bus
+                       matrix port, no contention with the CPU on SRAM1)
+     MCU_NOINIT        data kept across a reset, .noinit in SRAM2, neither
+                       initialized nor cleared by the startup code */
+  #define MCU_THREAD_STACK       __attribute__((section(".thread_stack"), aligned(8)))
+  #define MCU_DMA_BUFFER         __attribute__((section(".dma_buffer"), aligned(4)))
+  #define MCU_NOINIT             __attribute__((section(".noinit")))
+
 
   /* Base addresses for peripheral registers */
   #define SCB_BASE              0xE000ED00UL
@@ -123,17 +162,19 @@
   #define TIM2_BASE             0x40000000UL
   #define CPUID_BASE            0xE000ED00UL
   #define ICSR_BASE             0xE000ED04UL
+  #define DWT_BASE              0xE0001000UL
 
   /* Peripheral Interrupt Priority base */
-  #define NVIC_IPR_BASE     ICSR_BASE
+  #define NVIC_IPR_BASE     0xE000E400UL
 
   /* System Handler Priority Registers (SHP) */
-  #define NVIC_SYS_PRI1_R   (*((volatile uint32_t *)CPUID_BASE + 0x18UL)) // SHP[0]
-  #define NVIC_SYS_PRI2_R   (*((volatile uint32_t *)CPUID_BASE + 0x1CUL)) // SHP[1]
-  #define NVIC_SYS_PRI3_R   (*((volatile uint32_t *)CPUID_BASE + 0x20UL)) // SHP[2]
+  #define NVIC_SYS_PRI1_R   (*(volatile uint32_t *)(SCB_BASE + 0x18UL)) // SHP[0]
+  #define NVIC_SYS_PRI2_R   (*(volatile uint32_t *)(SCB_BASE + 0x1CUL)) // SHP[1]
+  #define NVIC_SYS_PRI3_R   (*(volatile uint32_t *)(SCB_BASE + 0x20UL)) // SHP[2]
 
   /* Interrupt control and state register */
   #define ICSR                 (*(volatile uint32_t*)(ICSR_BASE + 0x00UL))
+  #define ICSR_PENDSTSET       (1UL << 26U)
 
   /* ADC1 registers */
   #define ADC1_SR              (*(volatile uint32_t*)(ADC1_BASE + 0x00UL))
@@ -165,12 +206,25 @@
   /* SCB registers */
   #define SCB_CPACR            (*(volatile uint32_t*)(SCB_BASE + 0x88UL))
   #define SCB_SCR              (*(volatile uint32_t*)(SCB_BASE + 0x10UL))
+  #define SCB_VTOR             (*(volatile uint32_t*)(SCB_BASE + 0x08UL))
+  #define SCB_FPCCR            (*(volatile uint32_t*)(SCB_BASE + 0x234UL))
 
   /* SysTick registers */
   #define STK_CTRL             (*(volatile uint32_t*)(STK_BASE + 0x00UL))
   #define STK_LOAD             (*(volatile uint32_t*)(STK_BASE + 0x04UL))
   #define STK_VAL              (*(volatile uint32_t*)(STK_BASE + 0x08UL))
 
+  /* SysTick control bits and 1 ms reload value (180 MHz core clock) */
+  #define STK_CTRL_ENABLE      (1UL << 0U)
+  #define STK_CTRL_COUNTFLAG   (1UL << 16U)
+  #define STK_RELOAD_1MS       (180000UL)
+  #define STK_MAX_IDLE_TICKS   (0x00FFFFFFUL / STK_RELOAD_1MS)
+
+  /* DWT cycle counter registers */
+  #define SCB_DEMCR            (*(volatile uint32_t*)(SCB_BASE + 0xFCUL))
+  #define DWT_CTRL             (*(volatile uint32_t*)(DWT_BASE + 0x00UL))
+  #define DWT_CYCCNT           (*(volatile uint32_t*)(DWT_BASE + 0x04UL))
+
   /* RCC Registers */
   #define RCC_CR               (*(volatile uint32_t*)(RCC_BASE + 0x00UL))
   #define RCC_PLLCFGR          (*(volatile uint32_t*)(RCC_BASE + 0x04UL))
@@ -202,6 +256,7 @@
   #define GPIOA_OSPEEDR        (*(volatile uint32_t*)(GPIOA_BASE + 0x08UL))
   #define GPIOA_PUPDR          (*(volatile uint32_t*)(GPIOA_BASE + 0x0CUL))
   #define GPIOA_ODR            (*(volatile uint32_t*)(GPIOA_BASE + 0x14UL))
+  #define GPIOA_BSRR           (*(volatile uint32_t*)(GPIOA_BASE + 0x18UL))
   #define GPIOA_AFRL           (*(volatile uint32_t*)(GPIOA_BASE + 0x20UL))
 
   /* GPIOC registers */
@@ -209,6 +264,7 @@
   #define GPIOC_PUPDR          (*(volatile uint32_t*)(GPIOC_BASE + 0x0CUL))
   #define GPIOC_IDR            (*(volatile uint32_t*)(GPIOC_BASE + 0x10UL))
   #define GPIOC_ODR            (*(volatile uint32_t*)(GPIOC_BASE + 0x14UL))
+  #define GPIOC_BSRR           (*(volatile uint32_t*)(GPIOC_BASE + 0x18UL))
 
   /* TIM2 registers */
   #define TIM2_CR1             (*(volatile uint32_t*)(TIM2_BASE + 0x00UL))
@@ -225,6 +281,15 @@
   #define TIM2_CCR1            (*(volatile uint32_t*)(TIM2_BASE + 0x34UL))
   #define TIM2_CCR2            (*(volatile uint32_t*)(TIM2_BASE + 0x38UL))
 
+  /* TIM2 control bits and prescaler for a 1 MHz count (APB1 timer clock 90 MHz) */
+  #define RCC_APB1ENR_TIM2EN   (1UL << 0U)
+  #define TIM_CR1_CEN          (1UL << 0U)
+  #define TIM_DIER_CC1IE       (1UL << 1U)
+  #define TIM_SR_CC1IF         (1UL << 1U)
+  #define TIM_EGR_UG           (1UL << 0U)
+  #define TIM_EGR_CC1G         (1UL << 1U)
+  #define TIM2_PSC_1MHZ        (90UL - 1UL)
+
   #define DMA1_LISR            (*(volatile uint32_t*)(DMA1_BASE + 0x00UL))
   #define DMA1_HISR            (*(volatile uint32_t*)(DMA1_BASE + 0x04UL))
   #define DMA1_LIFCR           (*(volatile uint32_t*)(DMA1_BASE + 0x08UL))
@@ -243,10 +308,16 @@
   void SystemInit        (void);
   void SetSysClock       (void);
   void SysTick_Init      (void);
+  void Dwt_Init          (void);
   void Enable_Irq        (void);
   void Disable_Irq       (void);
+  uint32_t Mask_Irq      (uint32_t Priority);
+  void Restore_Irq       (uint32_t Mask);
   void Wait_For_Interrupt(void);
 
   void NVIC_SetPriority(int32_t IRQn, uint32_t priority);
 
+  bool     SysTick_StartOneShot(uint32_t Ticks);
+  uint32_t SysTick_StopOneShot (void);
+
 #endif // MCU_2023_08_19_H
@@ -0,0 +1,217 @@
+#include <stddef.h>
+#include <stdint.h>
+#include "Mcal/Mcu.h"
+#include "OS/Os.h"
+#include "OsPort.h"
+
+
+/* PendSV_Handler accesses the TCB with fixed offsets */
+_Static_assert(offsetof(OSThread, MyStckPointer) == 0x00U, "PendSV_Handler expects MyStckPointer at offset 0");
+_Static_assert(offsetof(OSThread, ExcReturn)     == 0x04U, "PendSV_Handler expects ExcReturn at offset 4");
+_Static_assert(offsetof(OSThread, StkLimit)      == 0x08U, "PendSV_Handler expects StkLimit at offset 8");
+
+/* The kernel ceiling is written to BASEPRI (4 priority bits) and must stay above PendSV */
+_Static_assert((OS_CFG_KERNEL_IRQ_PRIO >= 1) && (OS_CFG_KERNEL_IRQ_PRIO <= 14), "OS_CFG_KERNEL_IRQ_PRIO must be 1 .. 14");
+
+/* EXC_RETURN: return to thread mode, use PSP, basic frame (no FPU state) */
+#define OS_EXC_RETURN_THREAD  0xFFFFFFFDUL
+
+/* BASEPRI value masking the kernel interrupts, as assembler text */
+#define OS_PORT_BASEPRI       (OS_CFG_KERNEL_IRQ_PRIO << 4)
+#define OS_PORT_STR(x)        #x
+#define OS_PORT_XSTR(x)       OS_PORT_STR(x)
+
+
+/*----------------------------------------------------------------------------
+- Port Function Declarations
+-----------------------------------------------------------------------------*/
+MCU_RAMFUNC __attribute__ ((naked)) void PendSV_Handler(void);
+
+
+/*----------------------------------------------------------------------------
+- @brief OSPort_Init
+
+- @desc Sets PendSV to the lowest priority, so that the context switch
+        runs after all other interrupts, and keeps lazy FPU stacking on.
+
+- @param void
+
+- @return void
+-----------------------------------------------------------------------------*/
+void OSPort_Init(void)
+{
+  /* set the PendSV interrupt priority to the lowest level 0xFF */
+  NVIC_SYS_PRI3_R |= (0xFFUL << 16U);
+
+  /* Keep automatic and lazy FPU state preservation enabled (ASPEN, LSPEN) */
+  SCB_FPCCR |= (uint32_t)((1UL << 31U) | (1UL << 30U));
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief OSPort_StackInit
+
+- @desc Builds the Cortex-M exception stack frame and the fake r4-r11 below
+        the top of a thread stack, as restored by PendSV_Handler on the
+        first switch to the thread. Threads run on the PSP, interrupts on
+        the MSP, so a thread stack only holds the thread's own frames and
+        one exception frame.
+
+- @param TCB            Thread control block
+         ThreadHandler  Entry function of the thread
+         ThreadExit     Return address of the entry function
+         StckTop        Top of the stack (8-byte aligned)
+
+- @return void
+-----------------------------------------------------------------------------*/
+void OSPort_StackInit(OSThread *TCB, OSThreadHandler ThreadHandler, void (*ThreadExit)(void), uint32_t *StckTop)
+{
+  uint32_t *StckPointer = StckTop;
+
+  /* Initialize Cortex-M exception stack frame (automatically saved on exception entry) */
+  *(--StckPointer) = (1U << 24);              /* xPSR */
+  *(--StckPointer) = (uint32_t)ThreadHandler; /* PC   */
+  *(--StckPointer) = (uint32_t)ThreadExit;    /* LR   */
+  *(--StckPointer) = 0x0000000CU;             /* R12  */
+  *(--StckPointer) = 0x00000003U;             /* R3   */
+  *(--StckPointer) = 0x00000002U;             /* R2   */
+  *(--StckPointer) = 0x00000001U;             /* R1   */
+  *(--StckPointer) = 0x00000000U;             /* R0   */
+  /* additionally, fake registers R4-R11     */
+  *(--StckPointer) = 0x0000000BU;             /* R11  */
+  *(--StckPointer) = 0x0000000AU;             /* R10  */
+  *(--StckPointer) = 0x00000009U;             /* R9   */
+  *(--StckPointer) = 0x00000008U;             /* R8   */
+  *(--StckPointer) = 0x00000007U;             /* R7   */
+  *(--StckPointer) = 0x00000006U;             /* R6   */
+  *(--StckPointer) = 0x00000005U;             /* R5   */
+  *(--StckPointer) = 0x00000004U;             /* R4   */
+
+  /* Save top of stack pointer in TCB */
+  TCB->MyStckPointer = StckPointer;
+
+  /* Return to thread mode on PSP with a basic (non-FPU) frame */
+  TCB->ExcReturn     = OS_EXC_RETURN_THREAD;
+}
+
+
+/*----------------------------------------------------------------------------
+- @brief PendSV_Handler
+
+- @desc Performs RTOS context switching: saves current thread state,
+        restores next thread state, and updates OS_Curr pointer.
+        Threads run on the PSP: the context is stacked there with
+        STMDB/LDMIA while the handler itself stays on the MSP. The
+        EXC_RETURN value of each thread is kept in its TCB. The high FPU
+        registers s16-s31 are only saved/restored for threads whose
+        EXC_RETURN indicates an extended (FPU) frame, so integer threads
+        pay no extra cycles; s0-s15 are handled by lazy stacking.
+        Only the takeover of OS_Next (and the statistics and trace
+        hooks) is masked, with BASEPRI at the kernel ceiling: more
+        urgent interrupts are never delayed.
+        With OS_CFG_THREAD_STATS the cycles of the outgoing thread are
+        accounted before OS_curr changes, with OS_CFG_TRACE the switch is
+        recorded.
+        On the first switch main() is left for good: the MSP restarts
+        from its initial value for the interrupts.
+
+- @param void
+
+- @return void
+-----------------------------------------------------------------------------*/
+MCU_RAMFUNC __attribute__ ((naked)) void PendSV_Handler(void)
+{
+  __asm volatile
+  (
+    /* r0 = psp; r3 = &OS_curr; r1 = OS_curr; */
+    "  MRS           r0,psp             \n"
+    "  LDR           r3,=OS_Curr        \n"
+    "  LDR           r1,[r3,#0x00]      \n"
+
+    /* if (OS_curr != (OSThread *)0) { */
+    "  CMP           r1,#0              \n"
+    "  BEQ           PendSV_first       \n"
+
+    /* if the thread used the FPU (EXC_RETURN bit 4 clear), push s16-s31 */
+    "  TST           lr,#0x10           \n"
+    "  IT            EQ                 \n"
+    "  VSTMDBEQ      r0!,{s16-s31}      \n"
+
+    /* push registers r4-r11 on the thread stack */
+    "  STMDB         r0!,{r4-r11}       \n"
+
+    /* OS_curr->sp = psp; OS_curr->ExcReturn = lr; */
+    "  STMIA         r1,{r0,lr}         \n"
+
+#if (OS_CFG_STACK_CHECK == 1)
+    /* if (psp <= OS_curr->StkLimit || *OS_curr->StkLimit != OS_STACK_FILL) */
+    "  LDR           r2,[r1,#0x08]      \n"
+    "  CMP           r0,r2              \n"
+    "  BLS           PendSV_overflow    \n"
+    "  LDR           r2,[r2,#0x00]      \n"
+    "  LDR           r12,=0xFACEB00C    \n"
+    "  CMP           r2,r12             \n"
+    "  BNE           PendSV_overflow    \n"
+#endif
+
+    /* } */
+    "PendSV_restore:                    \n"
+
+    /* mask the kernel interrupts up to the takeover of OS_next */
+    "  MOV           r2,#" OS_PORT_XSTR(OS_PORT_BASEPRI) "\n"
+    "  MSR           basepri,r2         \n"
+
+#if (OS_CFG_THREAD_STATS == 1)
+    /* OS_StatsSwitch(); (clobbers r0-r3, r12 and lr, reloaded below) */
+    "  BL            OS_StatsSwitch     \n"
+#endif
+
+#if (OS_CFG_TRACE == 1)
+    /* OS_TraceSwitch(); */
+    "  BL            OS_TraceSwitch     \n"
+#endif
+
+#if ((OS_CFG_THREAD_STATS == 1) || (OS_CFG_TRACE == 1))
+    "  LDR           r3,=OS_Curr        \n"
+#endif
+
+    /* OS_curr = OS_next; unmask the kernel interrupts */
+    "  LDR           r1,=OS_Next        \n"
+    "  LDR           r1,[r1,#0x00]      \n"
+    "  STR           r1,[r3,#0x00]      \n"
+    "  MOV           r2,#0              \n"
+    "  MSR           basepri,r2         \n"
+
+    /* r0 = OS_next->sp; lr = OS_next->ExcReturn; */
+    "  LDMIA         r1,{r0,lr}         \n"
+
+    /* pop registers r4-r11 */
+    "  LDMIA         r0!,{r4-r11}       \n"
+
+    /* if the next thread used the FPU, pop s16-s31 */
+    "  TST           lr,#0x10           \n"
+    "  IT            EQ                 \n"
+    "  VLDMIAEQ      r0!,{s16-s31}      \n"
+
+    /* psp = r0; return to the next thread */
+    "  MSR           psp,r0             \n"
+    "  BX            lr                 \n"
+
+    /* First switch: msp = *(uint32_t *)VTOR; (initial stack pointer) */
+    "PendSV_first:                      \n"
+    "  LDR           r0,=0xE000ED08     \n"
+    "  LDR           r0,[r0,#0x00]      \n"
+    "  LDR           r0,[r0,#0x00]      \n"
+    "  MSR           msp,r0             \n"
+    "  B             PendSV_restore     \n"
+
+#if (OS_CFG_STACK_CHECK == 1)
+    /* OS_OnStackOverflow(OS_curr); (does not return, stays in flash:
+       branch through a register instead of a long-branch veneer) */
+    "PendSV_overflow:                   \n"
+    "  MOV           r0,r1              \n"
+    "  LDR           r2,=OS_OnStackOverflow \n"
+    "  BX            r2                 \n"
+#endif
+  );
+}